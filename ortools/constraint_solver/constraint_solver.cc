@@ -20,11 +20,13 @@
 #include <algorithm>
 #include <csetjmp>
 #include <cstdint>
+#include <cstring>
 #include <deque>
 #include <iosfwd>
 #include <limits>
 #include <memory>
 #include <ostream>
+#include <random>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -32,6 +34,7 @@
 
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
+#include "absl/random/distributions.h"
 #include "absl/time/time.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/map_util.h"
@@ -60,6 +63,9 @@ ABSL_FLAG(std::string, cp_profile_file, "",
           "Export profiling overview to file.");
 ABSL_FLAG(bool, cp_print_local_search_profile, false,
           "Print local search profiling data after solving.");
+ABSL_FLAG(int, cp_profile_sampling_period, 0,
+          "If positive, profiling only times one demon run or filter call "
+          "every cp_profile_sampling_period ones.");
 ABSL_FLAG(bool, cp_name_variables, false, "Force all variables to have names.");
 ABSL_FLAG(bool, cp_name_cast_variables, false,
           "Name variables casted from expressions");
@@ -141,6 +147,8 @@ ConstraintSolverParameters Solver::DefaultSolverParameters() {
       absl::GetFlag(FLAGS_cp_print_local_search_profile));
   params.set_print_local_search_profile(
       absl::GetFlag(FLAGS_cp_print_local_search_profile));
+  params.set_profile_sampling_period(
+      absl::GetFlag(FLAGS_cp_profile_sampling_period));
   params.set_print_model(absl::GetFlag(FLAGS_cp_print_model));
   params.set_print_model_stats(absl::GetFlag(FLAGS_cp_model_stats));
   params.set_disable_solve(absl::GetFlag(FLAGS_cp_disable_solve));
@@ -170,6 +178,8 @@ ConstraintSolverParameters Solver::DefaultSolverParameters() {
 extern void InstallDemonProfiler(DemonProfiler* monitor);
 extern DemonProfiler* BuildDemonProfiler(Solver* solver);
 extern void DeleteDemonProfiler(DemonProfiler* monitor);
+extern void DemonProfilerBeginSampledRun(DemonProfiler* monitor, Demon* demon);
+extern void DemonProfilerEndSampledRun(DemonProfiler* monitor, Demon* demon);
 extern void InstallLocalSearchProfiler(LocalSearchProfiler* monitor);
 extern LocalSearchProfiler* BuildLocalSearchProfiler(Solver* solver);
 extern void DeleteLocalSearchProfiler(LocalSearchProfiler* monitor);
@@ -181,6 +191,11 @@ bool Solver::InstrumentsDemons() const {
   return IsProfilingEnabled() || InstrumentsVariables();
 }
 
+bool Solver::SamplesDemons() const {
+  return IsProfilingEnabled() && parameters_.profile_sampling_period() > 0 &&
+         !InstrumentsVariables();
+}
+
 bool Solver::IsProfilingEnabled() const {
   return parameters_.profile_propagation() ||
          !parameters_.profile_file().empty();
@@ -235,7 +250,14 @@ class Queue {
         clean_action_(nullptr),
         clean_variable_(nullptr),
         in_add_(false),
-        instruments_demons_(s->InstrumentsDemons()) {}
+        instruments_demons_(s->InstrumentsDemons() && !s->SamplesDemons()),
+        sampling_period_(s->SamplesDemons()
+                             ? s->parameters().profile_sampling_period()
+                             : 0),
+        sampling_random_(/*seed=*/0),
+        runs_before_next_sample_(0) {
+    if (sampling_period_ > 0) runs_before_next_sample_ = NextSampleGap();
+  }
 
   ~Queue() {}
 
@@ -256,8 +278,7 @@ class Queue {
       if (++solver_->demon_runs_[demon->priority()] % kTestPeriod == 0) {
         solver_->TopPeriodicCheck();
       }
-      demon->Run(solver_);
-      solver_->CheckFail();
+      RunDemon(demon);
     } else {
       solver_->GetPropagationMonitor()->BeginDemonRun(demon);
       if (++solver_->demon_runs_[demon->priority()] % kTestPeriod == 0) {
@@ -298,8 +319,7 @@ class Queue {
               0) {
             solver_->TopPeriodicCheck();
           }
-          demon->Run(solver_);
-          solver_->CheckFail();
+          RunDemon(demon);
         }
       }
     } else {
@@ -406,6 +426,28 @@ class Queue {
   }
 
  private:
+  // Runs a demon without instrumentation, except for one run every
+  // sampling_period_ on average which is timed by the demon profiler.
+  void RunDemon(Demon* const demon) {
+    if (sampling_period_ == 0 || --runs_before_next_sample_ > 0) {
+      demon->Run(solver_);
+      solver_->CheckFail();
+      return;
+    }
+    runs_before_next_sample_ = NextSampleGap();
+    DemonProfilerBeginSampledRun(solver_->demon_profiler(), demon);
+    demon->Run(solver_);
+    solver_->CheckFail();
+    DemonProfilerEndSampledRun(solver_->demon_profiler(), demon);
+  }
+
+  // The number of runs until the next sample is drawn uniformly in
+  // [1, 2 * sampling_period_ - 1]. A fixed gap could always sample the same
+  // demon when demons are run in a cyclic order.
+  int64_t NextSampleGap() {
+    return absl::Uniform<int64_t>(sampling_random_, 1, 2 * sampling_period_);
+  }
+
   Solver* const solver_;
   std::deque<Demon*> var_queue_;
   std::deque<Demon*> delayed_queue_;
@@ -419,6 +461,9 @@ class Queue {
   std::vector<Constraint*> to_add_;
   bool in_add_;
   const bool instruments_demons_;
+  const int64_t sampling_period_;
+  std::mt19937 sampling_random_;
+  int64_t runs_before_next_sample_;
 };
 
 // ------------------ StateMarker / StateInfo struct -----------
@@ -511,7 +556,10 @@ struct addrval {
  public:
   addrval() : address_(nullptr) {}
   explicit addrval(T* adr) : address_(adr), old_value_(*adr) {}
+  addrval(T* adr, T old_value) : address_(adr), old_value_(old_value) {}
   void restore() const { (*address_) = old_value_; }
+  T* address() const { return address_; }
+  T old_value() const { return old_value_; }
 
  private:
   T* address_;
@@ -605,6 +653,104 @@ class ZlibTrailPacker : public TrailPacker<T> {
   std::unique_ptr<char[]> tmp_block_;
 };
 
+// Packs each entry as its difference with the previous entry of the block,
+// both for the address and the value, zigzag and varint encoded. Consecutive
+// entries mostly save fields of the same objects, with close values, so this
+// shrinks blocks nearly as much as zlib at a fraction of the cost.
+template <class T>
+class DeltaVarintTrailPacker : public TrailPacker<T> {
+ public:
+  explicit DeltaVarintTrailPacker(int block_size)
+      : TrailPacker<T>(block_size),
+        block_size_(block_size),
+        tmp_block_(new char[2 * kMaxVarintBytes * block_size]) {}
+
+  // This type is neither copyable nor movable.
+  DeltaVarintTrailPacker(const DeltaVarintTrailPacker&) = delete;
+  DeltaVarintTrailPacker& operator=(const DeltaVarintTrailPacker&) = delete;
+
+  ~DeltaVarintTrailPacker() override {}
+
+  void Pack(const addrval<T>* block, std::string* packed_block) override {
+    DCHECK(block != nullptr);
+    DCHECK(packed_block != nullptr);
+    char* out = tmp_block_.get();
+    uint64_t previous_address = 0;
+    uint64_t previous_value = 0;
+    for (int i = 0; i < block_size_; ++i) {
+      const uint64_t address = reinterpret_cast<uintptr_t>(block[i].address());
+      const uint64_t value = ToBits(block[i].old_value());
+      out = WriteVarint(ZigZagEncode(address - previous_address), out);
+      out = WriteVarint(ZigZagEncode(value - previous_value), out);
+      previous_address = address;
+      previous_value = value;
+    }
+    packed_block->assign(tmp_block_.get(), out - tmp_block_.get());
+  }
+
+  void Unpack(const std::string& packed_block, addrval<T>* block) override {
+    DCHECK(block != nullptr);
+    const char* in = packed_block.data();
+    uint64_t address = 0;
+    uint64_t value = 0;
+    for (int i = 0; i < block_size_; ++i) {
+      address += ZigZagDecode(ReadVarint(&in));
+      value += ZigZagDecode(ReadVarint(&in));
+      block[i] = addrval<T>(reinterpret_cast<T*>(address), FromBits(value));
+    }
+    DCHECK_EQ(in, packed_block.data() + packed_block.size());
+  }
+
+ private:
+  static constexpr int kMaxVarintBytes = 10;
+
+  // Integers are sign-extended so that small negative values stay small.
+  static uint64_t ToBits(T value) {
+    if constexpr (std::is_integral_v<T>) {
+      return static_cast<uint64_t>(static_cast<int64_t>(value));
+    } else {
+      uint64_t bits = 0;
+      memcpy(&bits, &value, sizeof(T));
+      return bits;
+    }
+  }
+  static T FromBits(uint64_t bits) {
+    if constexpr (std::is_integral_v<T>) {
+      return static_cast<T>(bits);
+    } else {
+      T value;
+      memcpy(&value, &bits, sizeof(T));
+      return value;
+    }
+  }
+  static uint64_t ZigZagEncode(uint64_t delta) {
+    const int64_t sign = static_cast<int64_t>(delta) >> 63;
+    return (delta << 1) ^ static_cast<uint64_t>(sign);
+  }
+  static uint64_t ZigZagDecode(uint64_t bits) {
+    return (bits >> 1) ^ (~(bits & 1) + 1);
+  }
+  static char* WriteVarint(uint64_t bits, char* out) {
+    while (bits >= 0x80) {
+      *out++ = static_cast<char>(bits | 0x80);
+      bits >>= 7;
+    }
+    *out++ = static_cast<char>(bits);
+    return out;
+  }
+  static uint64_t ReadVarint(const char** in) {
+    uint64_t bits = 0;
+    for (int shift = 0;; shift += 7) {
+      const uint8_t byte = static_cast<uint8_t>(*(*in)++);
+      bits |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (byte < 0x80) return bits;
+    }
+  }
+
+  const int block_size_;
+  std::unique_ptr<char[]> tmp_block_;
+};
+
 template <class T>
 class CompressedTrail {
  public:
@@ -618,7 +764,8 @@ class CompressedTrail {
         buffer_(new addrval<T>[block_size]),
         buffer_used_(false),
         current_(0),
-        size_(0) {
+        size_(0),
+        packed_bytes_(0) {
     switch (compression_level) {
       case ConstraintSolverParameters::NO_COMPRESSION: {
         packer_.reset(new NoCompressionTrailPacker<T>(block_size));
@@ -628,6 +775,10 @@ class CompressedTrail {
         packer_.reset(new ZlibTrailPacker<T>(block_size));
         break;
       }
+      case ConstraintSolverParameters::COMPRESS_WITH_DELTA_VARINT: {
+        packer_.reset(new DeltaVarintTrailPacker<T>(block_size));
+        break;
+      }
       default: {
         LOG(ERROR) << "Should not be here";
       }
@@ -660,6 +811,7 @@ class CompressedTrail {
           buffer_used_ = false;
         } else if (blocks_ != nullptr) {
           packer_->Unpack(blocks_->compressed, data_.get());
+          packed_bytes_ -= blocks_->compressed.size();
           FreeTopBlock();
           current_ = block_size_;
         }
@@ -672,6 +824,7 @@ class CompressedTrail {
       if (buffer_used_) {  // Buffer is used.
         NewTopBlock();
         packer_->Pack(buffer_.get(), &blocks_->compressed);
+        packed_bytes_ += blocks_->compressed.size();
         // O(1) operation.
         data_.swap(buffer_);
       } else {
@@ -685,6 +838,9 @@ class CompressedTrail {
     ++size_;
   }
   int64_t size() const { return size_; }
+  // Returns the size of the packed blocks; the last two blocks are kept
+  // unpacked and are not counted.
+  int64_t packed_bytes() const { return packed_bytes_; }
 
  private:
   struct Block {
@@ -727,6 +883,7 @@ class CompressedTrail {
   bool buffer_used_;
   int current_;
   int size_;
+  int64_t packed_bytes_;
 };
 }  // namespace
 
@@ -1431,6 +1588,7 @@ namespace {
 void CheckSolverParameters(const ConstraintSolverParameters& parameters) {
   CHECK_GT(parameters.array_split_size(), 0)
       << "Were parameters built using Solver::DefaultSolverParameters() ?";
+  CHECK_GE(parameters.profile_sampling_period(), 0);
 }
 }  // namespace
 
@@ -1548,6 +1706,14 @@ std::string Solver::DebugString() const {
 
 int64_t Solver::MemoryUsage() { return GetProcessMemoryUsage(); }
 
+int64_t Solver::TrailPackedBytes() const {
+  return trail_->rev_ints_.packed_bytes() +
+         trail_->rev_int64s_.packed_bytes() +
+         trail_->rev_uint64s_.packed_bytes() +
+         trail_->rev_doubles_.packed_bytes() +
+         trail_->rev_ptrs_.packed_bytes();
+}
+
 int64_t Solver::wall_time() const {
   return absl::ToInt64Milliseconds(timer_->GetDuration());
 }
@@ -1026,6 +1026,10 @@ class Solver {
   /// Current memory usage in bytes
   static int64_t MemoryUsage();
 
+  /// Current size in bytes of the packed blocks of the trail, which stores the
+  /// values to restore on backtrack; depends on the compress_trail parameter.
+  int64_t TrailPackedBytes() const;
+
   /// The 'absolute time' as seen by the solver. Unless a user-provided clock
   /// was injected via SetClock() (eg. for unit tests), this is a real walltime,
   /// shifted so that it was 0 at construction. All so-called "walltime" limits
@@ -3121,6 +3125,9 @@ class Solver {
   ModelCache* Cache() const;
   /// Returns whether we are instrumenting demons.
   bool InstrumentsDemons() const;
+  /// Returns whether demon runs are sampled by the profiler instead of being
+  /// all instrumented.
+  bool SamplesDemons() const;
   /// Returns whether we are profiling the solver.
   bool IsProfilingEnabled() const;
   /// Returns whether we are profiling local search.
@@ -137,6 +137,59 @@ public class RoutingSolverTest
         Assert.Equal(5, solution.ObjectiveValue());
     }
 
+    [Fact]
+    public void TestReoptimizeAfterUpdatesForNextSolves()
+    {
+        // A single vehicle on a line goes to the farthest node and back.
+        const int numNodes = 6;
+        long[][] matrix = new long[numNodes][];
+        for (int i = 0; i < numNodes; ++i)
+        {
+            matrix[i] = new long[numNodes];
+            for (int j = 0; j < numNodes; ++j)
+            {
+                matrix[i][j] = Math.Abs(i - j);
+            }
+        }
+        RoutingIndexManager manager = new RoutingIndexManager(numNodes, 1 /*vehicle*/, 0 /*depot*/);
+        RoutingModel routing = new RoutingModel(manager);
+        int transitIndex = routing.RegisterTransitMatrix(matrix);
+        routing.SetArcCostEvaluatorOfAllVehicles(transitIndex);
+        Assert.True(routing.AddDimension(transitIndex, 10, 100, true, "Time"));
+        RoutingDimension dimension = routing.GetDimensionOrDie("Time");
+        for (int node = 1; node < numNodes; ++node)
+        {
+            routing.AddDisjunction(new long[] { manager.NodeToIndex(node) }, 1000);
+        }
+        RoutingSearchParameters searchParameters =
+            operations_research_constraint_solver.DefaultRoutingSearchParameters();
+        searchParameters.FirstSolutionStrategy = FirstSolutionStrategy.Types.Value.PathCheapestArc;
+        Assignment solution = routing.SolveWithParameters(searchParameters);
+        Assert.NotNull(solution);
+        Assert.Equal(10, solution.ObjectiveValue());
+
+        // Remove the farthest node and narrow the time window of node 3.
+        long farthest = manager.NodeToIndex(5);
+        long narrowed = manager.NodeToIndex(3);
+        routing.SetIndexDeactivatedForNextSolves(farthest, true);
+        routing.SetCumulRangeForNextSolves(dimension, narrowed, 6, 10);
+        Assert.True(routing.IsIndexDeactivatedForNextSolves(farthest));
+        Assert.Equal(6, routing.GetCumulMinForNextSolves(dimension, narrowed));
+        Assert.Equal(10, routing.GetCumulMaxForNextSolves(dimension, narrowed));
+        solution = routing.ReoptimizeFromAssignmentWithParameters(solution, searchParameters);
+        Assert.NotNull(solution);
+        Assert.Equal(farthest, solution.Value(routing.NextVar(farthest)));
+        Assert.InRange(solution.Value(dimension.CumulVar(narrowed)), 6, 10);
+        Assert.Equal(1008, solution.ObjectiveValue());
+
+        // Reverting the updates restores the original optimum.
+        routing.ClearUpdatesForNextSolves();
+        Assert.False(routing.IsIndexDeactivatedForNextSolves(farthest));
+        solution = routing.ReoptimizeFromAssignmentWithParameters(solution, searchParameters);
+        Assert.NotNull(solution);
+        Assert.Equal(10, solution.ObjectiveValue());
+    }
+
     [Fact]
     public void TestUnaryTransitVector()
     {
@@ -100,6 +100,7 @@ using System.Collections.Generic;
   }
 %}
 %ignore RoutingDimension::GetBreakDistanceDurationOfVehicle;
+%ignore RoutingDimension::GetTransitMatrixOrNull;
 
 // RoutingModel
 %unignore RoutingModel;
@@ -163,6 +164,7 @@ using Domain = Google.OrTools.Util.Domain;
 %ignore RoutingModel::HasTypeRegulations;
 %ignore RoutingModel::MakeStateDependentTransit;
 %ignore RoutingModel::PackCumulsOfOptimizerDimensionsFromAssignment;
+%ignore RoutingModel::RegisterCompactTransitMatrix;
 %ignore RoutingModel::RegisterStateDependentTransitCallback;
 %ignore RoutingModel::RemainingTime;
 %ignore RoutingModel::StateDependentTransitCallback;
@@ -173,7 +175,13 @@ using Domain = Google.OrTools.Util.Domain;
       const Assignment* assignment,
       const RoutingSearchParameters& search_parameters,
       std::vector<const Assignment*>* solutions);
+%ignore RoutingModel::ReoptimizeFromAssignmentWithParameters(
+      const Assignment* assignment,
+      const RoutingSearchParameters& search_parameters,
+      std::vector<const Assignment*>* solutions);
 %ignore RoutingModel::TransitCallback;
+%ignore RoutingModel::TransitMatrixOrNull;
+%ignore RoutingModel::EvaluateTransit;
 %ignore RoutingModel::UnaryTransitCallbackOrNull;
 
 // RoutingModelVisitor
@@ -56,7 +56,10 @@ class DemonProfiler : public PropagationMonitor {
       : PropagationMonitor(solver),
         active_constraint_(nullptr),
         active_demon_(nullptr),
-        start_time_ns_(absl::GetCurrentTimeNanos()) {}
+        start_time_ns_(absl::GetCurrentTimeNanos()),
+        sampling_period_(solver->SamplesDemons()
+                             ? solver->parameters().profile_sampling_period()
+                             : 0) {}
 
   ~DemonProfiler() override {
     gtl::STLDeleteContainerPairSecondPointers(constraint_map_.begin(),
@@ -141,6 +144,7 @@ class DemonProfiler : public PropagationMonitor {
       DemonRuns* const demon_run = ct_run->add_demons();
       demon_run->set_demon_id(demon->DebugString());
       demon_run->set_failures(0);
+      demon_run->set_sampling_period(sampling_period_);
       demon_map_[demon] = demon_run;
       demons_per_constraint_[active_constraint_].push_back(demon_run);
     }
@@ -268,7 +272,10 @@ class DemonProfiler : public PropagationMonitor {
         "runtime=%d us, [average=%.2lf, median=%.2lf, stddev=%.2lf]\n";
     File* file;
     const std::string model =
-        absl::StrFormat("Model %s:\n", solver->model_name());
+        sampling_period_ > 0
+            ? absl::StrFormat("Model %s (1 demon run sampled every %d):\n",
+                              solver->model_name(), sampling_period_)
+            : absl::StrFormat("Model %s:\n", solver->model_name());
     if (file::Open(filename, "w", &file, file::Defaults()).ok()) {
       file::WriteString(file, model, file::Defaults()).IgnoreError();
       std::vector<Container> to_sort;
@@ -352,14 +359,15 @@ class DemonProfiler : public PropagationMonitor {
     CHECK_EQ(*demons, demons_per_constraint_[constraint].size());
     for (int demon_index = 0; demon_index < *demons; ++demon_index) {
       const DemonRuns& demon_runs = ct_run->demons(demon_index);
-      *fails += demon_runs.failures();
+      const int64_t weight = SampleWeight(demon_runs);
+      *fails += weight * demon_runs.failures();
       CHECK_EQ(demon_runs.start_time_size(), demon_runs.end_time_size());
       const int runs = demon_runs.start_time_size();
-      *demon_invocations += runs;
+      *demon_invocations += weight * runs;
       for (int run_index = 0; run_index < runs; ++run_index) {
         const int64_t demon_time =
             demon_runs.end_time(run_index) - demon_runs.start_time(run_index);
-        *total_demon_runtime += demon_time;
+        *total_demon_runtime += weight * demon_time;
       }
     }
   }
@@ -373,9 +381,12 @@ class DemonProfiler : public PropagationMonitor {
     CHECK(demon_runs != nullptr);
     CHECK_EQ(demon_runs->start_time_size(), demon_runs->end_time_size());
 
+    // The mean, median and standard deviation are computed on the sampled runs,
+    // the totals are extrapolated to all the runs.
+    const int64_t weight = SampleWeight(*demon_runs);
     const int runs = demon_runs->start_time_size();
-    *demon_invocations = runs;
-    *fails = demon_runs->failures();
+    *demon_invocations = weight * runs;
+    *fails = weight * demon_runs->failures();
     *total_demon_runtime = 0;
     *mean_demon_runtime = 0.0;
     *median_demon_runtime = 0.0;
@@ -390,6 +401,7 @@ class DemonProfiler : public PropagationMonitor {
     // Compute mean.
     if (!runtimes.empty()) {
       *mean_demon_runtime = (1.0L * *total_demon_runtime) / runtimes.size();
+      *total_demon_runtime *= weight;
 
       // Compute median.
       std::sort(runtimes.begin(), runtimes.end());
@@ -423,9 +435,15 @@ class DemonProfiler : public PropagationMonitor {
   std::string DebugString() const override { return "DemonProfiler"; }
 
  private:
+  // The number of runs represented by each recorded run of 'demon_runs'.
+  static int64_t SampleWeight(const DemonRuns& demon_runs) {
+    return std::max<int64_t>(1, demon_runs.sampling_period());
+  }
+
   Constraint* active_constraint_;
   Demon* active_demon_;
   const int64_t start_time_ns_;
+  const int64_t sampling_period_;
   absl::flat_hash_map<const Constraint*, ConstraintRuns*> constraint_map_;
   absl::flat_hash_map<const Demon*, DemonRuns*> demon_map_;
   absl::flat_hash_map<const Constraint*, std::vector<DemonRuns*> >
@@ -452,6 +470,14 @@ DemonProfiler* BuildDemonProfiler(Solver* solver) {
 
 void DeleteDemonProfiler(DemonProfiler* monitor) { delete monitor; }
 
+void DemonProfilerBeginSampledRun(DemonProfiler* monitor, Demon* demon) {
+  monitor->BeginDemonRun(demon);
+}
+
+void DemonProfilerEndSampledRun(DemonProfiler* monitor, Demon* demon) {
+  monitor->EndDemonRun(demon);
+}
+
 Demon* Solver::RegisterDemon(Demon* const demon) {
   CHECK(demon != nullptr);
   if (InstrumentsDemons()) {
@@ -21,6 +21,7 @@ import static org.junit.jupiter.api.Assertions.assertTrue;
 
 import com.google.auto.value.AutoValue;
 import com.google.ortools.Loader;
+import com.google.ortools.constraintsolver.FirstSolutionStrategy;
 import com.google.ortools.constraintsolver.RoutingModelParameters;
 import com.google.ortools.constraintsolver.RoutingSearchParameters;
 import com.google.ortools.constraintsolver.RoutingSearchStatus;
@@ -516,6 +517,57 @@ public final class RoutingSolverTest {
     }
   }
 
+  @Test
+  public void testRoutingModel_reoptimizeAfterUpdatesForNextSolves() {
+    // A single vehicle on a line goes to the farthest node and back.
+    final int numNodes = 6;
+    final long[][] matrix = new long[numNodes][numNodes];
+    for (int i = 0; i < numNodes; i++) {
+      for (int j = 0; j < numNodes; j++) {
+        matrix[i][j] = Math.abs(i - j);
+      }
+    }
+    final RoutingIndexManager manager = new RoutingIndexManager(numNodes, 1, 0);
+    final RoutingModel model = new RoutingModel(manager);
+    final int transit = model.registerTransitMatrix(matrix);
+    model.setArcCostEvaluatorOfAllVehicles(transit);
+    assertTrue(model.addDimension(transit, 10, 100, true, "time"));
+    final RoutingDimension dimension = model.getMutableDimension("time");
+    for (int node = 1; node < numNodes; node++) {
+      int unused = model.addDisjunction(manager.nodesToIndices(new int[] {node}), 1000);
+    }
+    final RoutingSearchParameters parameters =
+        main.defaultRoutingSearchParameters()
+            .toBuilder()
+            .setFirstSolutionStrategy(FirstSolutionStrategy.Value.PATH_CHEAPEST_ARC)
+            .build();
+    Assignment solution = model.solveWithParameters(parameters);
+    assertNotNull(solution);
+    assertEquals(10, solution.objectiveValue());
+
+    // Remove the farthest node and narrow the time window of node 3.
+    final long farthest = manager.nodeToIndex(5);
+    final long narrowed = manager.nodeToIndex(3);
+    model.setIndexDeactivatedForNextSolves(farthest, true);
+    model.setCumulRangeForNextSolves(dimension, narrowed, 6, 10);
+    assertTrue(model.isIndexDeactivatedForNextSolves(farthest));
+    assertEquals(6, model.getCumulMinForNextSolves(dimension, narrowed));
+    assertEquals(10, model.getCumulMaxForNextSolves(dimension, narrowed));
+    solution = model.reoptimizeFromAssignmentWithParameters(solution, parameters);
+    assertNotNull(solution);
+    assertEquals(farthest, solution.value(model.nextVar(farthest)));
+    final long cumul = solution.value(dimension.cumulVar(narrowed));
+    assertTrue(cumul >= 6 && cumul <= 10);
+    assertEquals(1008, solution.objectiveValue());
+
+    // Reverting the updates restores the original optimum.
+    model.clearUpdatesForNextSolves();
+    assertFalse(model.isIndexDeactivatedForNextSolves(farthest));
+    solution = model.reoptimizeFromAssignmentWithParameters(solution, parameters);
+    assertNotNull(solution);
+    assertEquals(10, solution.objectiveValue());
+  }
+
   @Test
   public void testRoutingModel_dimensionVehicleSpanCost() {
     final RoutingIndexManager manager = new RoutingIndexManager(2, 1, 0);
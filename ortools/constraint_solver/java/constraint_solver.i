@@ -1126,6 +1126,7 @@ import java.util.HashSet;
 %rename (solveDepth) Solver::SolveDepth;
 %rename (topPeriodicCheck) Solver::TopPeriodicCheck;
 %rename (topProgressPercent) Solver::TopProgressPercent;
+%rename (trailPackedBytes) Solver::TrailPackedBytes;
 %rename (tryDecisions) Solver::Try;
 %rename (updateLimits) Solver::UpdateLimits;
 %rename (wallTime) Solver::wall_time;
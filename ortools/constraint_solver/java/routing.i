@@ -117,6 +117,7 @@ import java.util.function.LongUnaryOperator;
 %ignore RoutingModel::HasTypeRegulations;
 %ignore RoutingModel::MakeStateDependentTransit;
 %ignore RoutingModel::PackCumulsOfOptimizerDimensionsFromAssignment;
+%ignore RoutingModel::RegisterCompactTransitMatrix;
 %ignore RoutingModel::RegisterStateDependentTransitCallback;
 %ignore RoutingModel::RemainingTime;
 %ignore RoutingModel::SolveWithParameters(
@@ -126,8 +127,14 @@ import java.util.function.LongUnaryOperator;
       const Assignment* assignment,
       const RoutingSearchParameters& search_parameters,
       std::vector<const Assignment*>* solutions);
+%ignore RoutingModel::ReoptimizeFromAssignmentWithParameters(
+      const Assignment* assignment,
+      const RoutingSearchParameters& search_parameters,
+      std::vector<const Assignment*>* solutions);
 %ignore RoutingModel::TransitCallback;
 %ignore RoutingModel::StateDependentTransitCallback;
+%ignore RoutingModel::TransitMatrixOrNull;
+%ignore RoutingModel::EvaluateTransit;
 %ignore RoutingModel::UnaryTransitCallbackOrNull;
 %rename (activeVar) RoutingModel::ActiveVar;
 %rename (activeVehicleVar) RoutingModel::ActiveVehicleVar;
@@ -164,6 +171,8 @@ import java.util.function.LongUnaryOperator;
 %rename (arcIsMoreConstrainedThanArc) RoutingModel::ArcIsMoreConstrainedThanArc;
 %rename (assignmentToRoutes) RoutingModel::AssignmentToRoutes;
 %rename (checkLimit) RoutingModel::CheckLimit;
+%rename (clearCumulRangeForNextSolves) RoutingModel::ClearCumulRangeForNextSolves;
+%rename (clearUpdatesForNextSolves) RoutingModel::ClearUpdatesForNextSolves;
 %rename (closeModel) RoutingModel::CloseModel;
 %rename (closeModelWithParameters) RoutingModel::CloseModelWithParameters;
 %rename (closeVisitTypes) RoutingModel::CloseVisitTypes;
@@ -181,6 +190,8 @@ import java.util.function.LongUnaryOperator;
 %rename (getArcCostForVehicle) RoutingModel::GetArcCostForVehicle;
 %rename (getCostClassIndexOfVehicle) RoutingModel::GetCostClassIndexOfVehicle;
 %rename (getCostClassesCount) RoutingModel::GetCostClassesCount;
+%rename (getCumulMaxForNextSolves) RoutingModel::GetCumulMaxForNextSolves;
+%rename (getCumulMinForNextSolves) RoutingModel::GetCumulMinForNextSolves;
 %rename (getDepot) RoutingModel::GetDepot;
 %rename (getDimensionOrDie) RoutingModel::GetDimensionOrDie;
 %rename (getDisjunctionIndices) RoutingModel::GetDisjunctionIndices;
@@ -210,6 +221,7 @@ import java.util.function.LongUnaryOperator;
 %rename (hasVehicleWithCostClassIndex) RoutingModel::HasVehicleWithCostClassIndex;
 %rename (ignoreDisjunctionsAlreadyForcedToZero) RoutingModel::IgnoreDisjunctionsAlreadyForcedToZero;
 %rename (isEnd) RoutingModel::IsEnd;
+%rename (isIndexDeactivatedForNextSolves) RoutingModel::IsIndexDeactivatedForNextSolves;
 %rename (isMatchingModel) RoutingModel::IsMatchingModel;
 %rename (isStart) RoutingModel::IsStart;
 %rename (isVehicleAllowedForIndex) RoutingModel::IsVehicleAllowedForIndex;
@@ -230,6 +242,7 @@ import java.util.function.LongUnaryOperator;
 %rename (registerTransitMatrix) RoutingModel::RegisterTransitMatrix;
 %rename (registerTransitCallback) RoutingModel::RegisterTransitCallback;
 
+%rename (reoptimizeFromAssignmentWithParameters) RoutingModel::ReoptimizeFromAssignmentWithParameters;
 %rename (restoreAssignment) RoutingModel::RestoreAssignment;
 %rename (routesToAssignment) RoutingModel::RoutesToAssignment;
 %rename (setAllowedVehiclesForIndex) RoutingModel::SetAllowedVehiclesForIndex;
@@ -238,9 +251,11 @@ import java.util.function.LongUnaryOperator;
 %rename (setArcCostEvaluatorOfAllVehicles) RoutingModel::SetArcCostEvaluatorOfAllVehicles;
 %rename (setArcCostEvaluatorOfVehicle) RoutingModel::SetArcCostEvaluatorOfVehicle;
 %rename (setAssignmentFromOtherModelAssignment) RoutingModel::SetAssignmentFromOtherModelAssignment;
+%rename (setCumulRangeForNextSolves) RoutingModel::SetCumulRangeForNextSolves;
 %rename (setFirstSolutionEvaluator) RoutingModel::SetFirstSolutionEvaluator;
 %rename (setFixedCostOfAllVehicles) RoutingModel::SetFixedCostOfAllVehicles;
 %rename (setFixedCostOfVehicle) RoutingModel::SetFixedCostOfVehicle;
+%rename (setIndexDeactivatedForNextSolves) RoutingModel::SetIndexDeactivatedForNextSolves;
 %rename (setPickupAndDeliveryPolicyOfAllVehicles) RoutingModel::SetPickupAndDeliveryPolicyOfAllVehicles;
 %rename (setPickupAndDeliveryPolicyOfVehicle) RoutingModel::SetPickupAndDeliveryPolicyOfVehicle;
 %rename (setPrimaryConstrainedDimension) RoutingModel::SetPrimaryConstrainedDimension;
@@ -280,6 +295,7 @@ import com.google.ortools.constraintsolver.IntIntToLongFunction;
 import java.util.function.LongBinaryOperator;
 %}
 %ignore RoutingDimension::GetBreakDistanceDurationOfVehicle;
+%ignore RoutingDimension::GetTransitMatrixOrNull;
 %rename (addNodePrecedence) RoutingDimension::AddNodePrecedence;
 %rename (cumulVar) RoutingDimension::CumulVar;
 %rename (fixedTransitVar) RoutingDimension::FixedTransitVar;
@@ -3407,12 +3407,19 @@ bool LocalSearchState::PropagateTighten(VariableDomainId domain_id) {
 
 class LocalSearchProfiler : public LocalSearchMonitor {
  public:
-  explicit LocalSearchProfiler(Solver* solver) : LocalSearchMonitor(solver) {}
+  explicit LocalSearchProfiler(Solver* solver)
+      : LocalSearchMonitor(solver),
+        filter_sampling_period_(std::max<int64_t>(
+            1, solver->parameters().profile_sampling_period())),
+        sampling_random_(/*seed=*/0),
+        filter_calls_before_next_sample_(NextFilterSampleGap()) {}
   std::string DebugString() const override { return "LocalSearchProfiler"; }
   void RestartSearch() override {
     operator_stats_.clear();
     filter_stats_per_context_.clear();
     last_operator_ = nullptr;
+    sampled_filter_ = nullptr;
+    filter_calls_before_next_sample_ = NextFilterSampleGap();
   }
   void ExitSearch() override {
     // Update times for current operator when the search ends.
@@ -3529,6 +3536,9 @@ class LocalSearchProfiler : public LocalSearchMonitor {
         solver()->filtered_neighbors());
     statistics_proto.set_total_num_accepted_neighbors(
         solver()->accepted_neighbors());
+    if (filter_sampling_period_ > 1) {
+      statistics_proto.set_filter_sampling_period(filter_sampling_period_);
+    }
     return statistics_proto;
   }
   std::string PrintOverview() const {
@@ -3672,18 +3682,25 @@ class LocalSearchProfiler : public LocalSearchMonitor {
       operator_stats_[op->Self()].accepted_neighbors++;
     }
   }
+  // Only one filter call every filter_sampling_period_ on average is
+  // profiled, and accounts for filter_sampling_period_ calls.
   void BeginFiltering(const LocalSearchFilter* filter) override {
+    if (--filter_calls_before_next_sample_ > 0) return;
+    filter_calls_before_next_sample_ = NextFilterSampleGap();
+    sampled_filter_ = filter;
     FilterStats& filter_stats =
         filter_stats_per_context_[solver()->context()][filter];
-    filter_stats.calls++;
+    filter_stats.calls += filter_sampling_period_;
     filter_timer_.Start();
   }
   void EndFiltering(const LocalSearchFilter* filter, bool reject) override {
+    if (sampled_filter_ != filter) return;
+    sampled_filter_ = nullptr;
     filter_timer_.Stop();
     auto& stats = filter_stats_per_context_[solver()->context()][filter];
-    stats.seconds += filter_timer_.Get();
+    stats.seconds += filter_sampling_period_ * filter_timer_.Get();
     if (reject) {
-      stats.rejects++;
+      stats.rejects += filter_sampling_period_;
     }
   }
   void AddFirstSolutionProfiledDecisionBuilder(
@@ -3694,6 +3711,14 @@ class LocalSearchProfiler : public LocalSearchMonitor {
   void Install() override { SearchMonitor::Install(); }
 
  private:
+  // The filters are called in a fixed cyclic order, so a fixed gap between
+  // samples could always sample the same filter. The gap is drawn uniformly
+  // in [1, 2 * filter_sampling_period_ - 1] instead.
+  int64_t NextFilterSampleGap() {
+    if (filter_sampling_period_ == 1) return 1;
+    return absl::Uniform<int64_t>(sampling_random_, 1,
+                                  2 * filter_sampling_period_);
+  }
   void UpdateTime() {
     if (last_operator_ != nullptr) {
       timer_.Stop();
@@ -3720,6 +3745,10 @@ class LocalSearchProfiler : public LocalSearchMonitor {
   WallTimer make_next_neighbor_timer_;
   WallTimer accept_neighbor_timer_;
   WallTimer filter_timer_;
+  const int64_t filter_sampling_period_;
+  std::mt19937 sampling_random_;
+  int64_t filter_calls_before_next_sample_;
+  const LocalSearchFilter* sampled_filter_ = nullptr;
   const LocalSearchOperator* last_operator_ = nullptr;
   absl::flat_hash_map<const LocalSearchOperator*, OperatorStats>
       operator_stats_;
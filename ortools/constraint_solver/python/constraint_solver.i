@@ -749,6 +749,7 @@ namespace operations_research {
 %unignore Solver::CheckAssignment;
 %unignore Solver::CheckConstraint;
 %unignore Solver::MemoryUsage;
+%unignore Solver::TrailPackedBytes;
 %unignore Solver::LocalSearchProfile;
 
 // Solver: IntVar creation. We always strip the "Make" prefix in python.
@@ -1151,6 +1152,7 @@ namespace operations_research {
 %unignore ConstraintSolverParameters::TrailCompression;
 %unignore ConstraintSolverParameters::NO_COMPRESSION;
 %unignore ConstraintSolverParameters::COMPRESS_WITH_ZLIB;
+%unignore ConstraintSolverParameters::COMPRESS_WITH_DELTA_VARINT;
 
 // ConstraintSolverParameters: methods.
 %unignore ConstraintSolverParameters::compress_trail;
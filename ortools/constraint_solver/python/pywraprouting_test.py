@@ -817,6 +817,93 @@ class TestPyWrapRoutingModel(absltest.TestCase):
             model.GetAutomaticFirstSolutionStrategy(),
         )
 
+    def testSolveWithRouteDecomposition(self):
+        # Identical copies of a model on a line, with one route per subproblem:
+        # each group of routes is optimized on one of the models, and an
+        # optimized route goes to its farthest node and back.
+        num_nodes = 21
+        num_vehicles = 4
+        matrix = [[abs(i - j) for j in range(num_nodes)] for i in range(num_nodes)]
+        managers = []
+        models = []
+        for _ in range(2):
+            manager = pywrapcp.RoutingIndexManager(num_nodes, num_vehicles, 0)
+            model = pywrapcp.RoutingModel(manager)
+            transit_idx = model.RegisterTransitMatrix(matrix)
+            model.SetArcCostEvaluatorOfAllVehicles(transit_idx)
+            managers.append(manager)
+            models.append(model)
+        search_parameters = pywrapcp.DefaultRoutingSearchParameters()
+        search_parameters.first_solution_strategy = (
+            routing_enums_pb2.FirstSolutionStrategy.FIRST_UNBOUND_MIN_VALUE
+        )
+        search_parameters.time_limit.seconds = 30
+        decomposition = search_parameters.route_decomposition_parameters
+        decomposition.num_routes_per_subproblem = 1
+        decomposition.subproblem_time_limit.seconds = 1
+        decomposition.max_rounds = 3
+        assignment = pywrapcp.RoutingModel.SolveWithRouteDecomposition(
+            models, search_parameters
+        )
+        self.assertIsNotNone(assignment)
+        model = models[0]
+        manager = managers[0]
+        visited_nodes = []
+        expected_cost = 0
+        for vehicle in range(num_vehicles):
+            index = assignment.Value(model.NextVar(model.Start(vehicle)))
+            route = []
+            while not model.IsEnd(index):
+                route.append(manager.IndexToNode(index))
+                index = assignment.Value(model.NextVar(index))
+            expected_cost += 2 * max(route, default=0)
+            visited_nodes.extend(route)
+        self.assertCountEqual(range(1, num_nodes), visited_nodes)
+        self.assertEqual(expected_cost, assignment.ObjectiveValue())
+
+    def testReoptimizeAfterUpdatesForNextSolves(self):
+        # A single vehicle on a line goes to the farthest node and back.
+        num_nodes = 6
+        matrix = [[abs(i - j) for j in range(num_nodes)] for i in range(num_nodes)]
+        manager = pywrapcp.RoutingIndexManager(num_nodes, 1, 0)
+        model = pywrapcp.RoutingModel(manager)
+        transit_idx = model.RegisterTransitMatrix(matrix)
+        model.SetArcCostEvaluatorOfAllVehicles(transit_idx)
+        model.AddDimension(transit_idx, 10, 100, True, "time")
+        time_dimension = model.GetDimensionOrDie("time")
+        for node in range(1, num_nodes):
+            model.AddDisjunction([manager.NodeToIndex(node)], 1000)
+        search_parameters = pywrapcp.DefaultRoutingSearchParameters()
+        search_parameters.first_solution_strategy = (
+            routing_enums_pb2.FirstSolutionStrategy.PATH_CHEAPEST_ARC
+        )
+        assignment = model.SolveWithParameters(search_parameters)
+        self.assertIsNotNone(assignment)
+        self.assertEqual(10, assignment.ObjectiveValue())
+        # Remove the farthest node and narrow the time window of node 3.
+        farthest = manager.NodeToIndex(5)
+        narrowed = manager.NodeToIndex(3)
+        model.SetIndexDeactivatedForNextSolves(farthest, True)
+        model.SetCumulRangeForNextSolves(time_dimension, narrowed, 6, 10)
+        self.assertTrue(model.IsIndexDeactivatedForNextSolves(farthest))
+        self.assertEqual(6, model.GetCumulMinForNextSolves(time_dimension, narrowed))
+        self.assertEqual(10, model.GetCumulMaxForNextSolves(time_dimension, narrowed))
+        assignment = model.ReoptimizeFromAssignmentWithParameters(
+            assignment, search_parameters
+        )
+        self.assertIsNotNone(assignment)
+        self.assertEqual(farthest, assignment.Value(model.NextVar(farthest)))
+        self.assertBetween(assignment.Value(time_dimension.CumulVar(narrowed)), 6, 10)
+        self.assertEqual(1008, assignment.ObjectiveValue())
+        # Reverting the updates restores the original optimum.
+        model.ClearUpdatesForNextSolves()
+        self.assertFalse(model.IsIndexDeactivatedForNextSolves(farthest))
+        assignment = model.ReoptimizeFromAssignmentWithParameters(
+            assignment, search_parameters
+        )
+        self.assertIsNotNone(assignment)
+        self.assertEqual(10, assignment.ObjectiveValue())
+
 
 class TestBoundCost(absltest.TestCase):
 
@@ -71,6 +71,9 @@ DEFINE_INDEX_TYPE_TYPEDEF(
 %ignore operations_research::RoutingModel::AddDimensionDependentDimensionWithVehicleCapacity;
 %ignore operations_research::RoutingModel::AddResourceGroup;
 %ignore operations_research::RoutingModel::GetResourceGroups;
+%ignore operations_research::RoutingModel::RegisterCompactTransitMatrix;
+%ignore operations_research::RoutingModel::TransitMatrixOrNull;
+%ignore operations_research::RoutingDimension::GetTransitMatrixOrNull;
 
 PY_PROTO_TYPEMAP(ortools.constraint_solver.routing_parameters_pb2,
                  RoutingModelParameters,
@@ -79,6 +82,10 @@ PY_PROTO_TYPEMAP(ortools.constraint_solver.routing_parameters_pb2,
                  RoutingSearchParameters,
                  operations_research::RoutingSearchParameters)
 
+// Support passing a list of models to SolveWithRouteDecomposition().
+PY_CONVERT_HELPER_PTR(RoutingModel);
+PY_CONVERT(RoutingModel);
+
 // Wrap routing_types.h, routing_parameters.h according to the SWIG style guide.
 %ignoreall
 %unignore RoutingTransitCallback1;
@@ -129,3 +136,13 @@ struct RoutingSearchStatus {
 // TODO(user): Use ignoreall/unignoreall for this one. A lot of work.
 //swiglint: disable include-h-allglobals
 %include "ortools/constraint_solver/routing.h"
+
+// The C++ method takes an absl::Span, which is not wrapped.
+%extend operations_research::RoutingModel {
+  static const operations_research::Assignment* SolveWithRouteDecomposition(
+      const std::vector<operations_research::RoutingModel*>& models,
+      const operations_research::RoutingSearchParameters& search_parameters) {
+    return operations_research::RoutingModel::SolveWithRouteDecomposition(
+        absl::MakeConstSpan(models), search_parameters);
+  }
+}
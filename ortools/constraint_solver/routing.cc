@@ -58,6 +58,7 @@
 #include "ortools/base/protoutil.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
@@ -168,6 +169,8 @@ const Assignment* RoutingModel::PackCumulsOfOptimizerDimensionsFromAssignment(
 
   std::vector<DecisionBuilder*> decision_builders;
   decision_builders.push_back(solver_->MakeRestoreAssignment(preassignment_));
+  decision_builders.push_back(
+      solver_->MakeRestoreAssignment(next_solves_updates_));
   decision_builders.push_back(
       solver_->MakeRestoreAssignment(packed_assignment));
   for (auto& [lp_optimizer, mp_optimizer] : local_dimension_optimizers_) {
@@ -219,6 +222,46 @@ SweepArranger* RoutingModel::sweep_arranger() const {
   return sweep_arranger_.get();
 }
 
+void RoutingModel::SetNodeCoordinates(
+    absl::Span<const std::pair<int64_t, int64_t>> node_coordinates) {
+  CHECK_EQ(node_coordinates.size(), manager_.num_nodes());
+  const int size = Size() + vehicles();
+  index_coordinates_.resize(size);
+  for (int index = 0; index < size; ++index) {
+    index_coordinates_[index] =
+        node_coordinates[manager_.IndexToNode(index).value()];
+  }
+  // Neighbors computed so far did not use the coordinates.
+  node_neighbors_by_cost_class_per_size_.clear();
+}
+
+namespace {
+// When coordinates are available, the neighbors of a node are selected among
+// this many times as many of its nearest nodes in the plane.
+constexpr int kNeighborCandidatesPerNeighbor = 2;
+
+// Calls f(begin, end) on blocks covering [0, size), using num_threads threads.
+void RunOnBlocks(int size, int num_threads,
+                 const std::function<void(int, int)>& f) {
+  num_threads = std::min(num_threads, size);
+  if (num_threads <= 1) {
+    f(0, size);
+    return;
+  }
+  // Smaller blocks than threads balance the load when some rows are cheaper,
+  // for instance those of the vehicle starts which are skipped.
+  const int num_blocks = std::min(size, 8 * num_threads);
+  ThreadPool pool(num_threads);
+  pool.StartWorkers();
+  for (int block = 0; block < num_blocks; ++block) {
+    const int begin = static_cast<int64_t>(size) * block / num_blocks;
+    const int end = static_cast<int64_t>(size) * (block + 1) / num_blocks;
+    pool.Schedule([&f, begin, end]() { f(begin, end); });
+  }
+  // The destructor of the pool waits for all the blocks.
+}
+}  // namespace
+
 void RoutingModel::NodeNeighborsByCostClass::ComputeNeighbors(
     const NodeNeighborsParameters& params) {
   auto [num_neighbors, add_vehicle_starts_to_neighbors,
@@ -255,211 +298,188 @@ void RoutingModel::NodeNeighborsByCostClass::ComputeNeighbors(
   }
 
   const int num_cost_classes = routing_model_.GetCostClassesCount();
-  node_index_to_incoming_neighbors_by_cost_class_.resize(num_cost_classes);
-  node_index_to_outgoing_neighbors_by_cost_class_.resize(num_cost_classes);
-  node_index_to_outgoing_neighbor_indicator_by_cost_class_.resize(
-      num_cost_classes);
-  std::vector<std::vector<std::vector<int64_t>>>
-      node_index_to_outgoing_costs_by_cost_class(num_cost_classes);
+  std::vector<int> cost_classes;
   for (int cc = 0; cc < num_cost_classes; cc++) {
-    if (!routing_model_.HasVehicleWithCostClassIndex(
+    // Skip cost classes without vehicles to avoid unnecessary computations.
+    if (routing_model_.HasVehicleWithCostClassIndex(
             RoutingCostClassIndex(cc))) {
-      continue;
-    }
-    node_index_to_incoming_neighbors_by_cost_class_[cc].resize(
-        size_with_vehicle_nodes);
-    node_index_to_outgoing_neighbors_by_cost_class_[cc].resize(size);
-    node_index_to_outgoing_neighbor_indicator_by_cost_class_[cc].resize(size);
-    node_index_to_outgoing_costs_by_cost_class[cc].resize(size);
-    for (int node = 0; node < size_with_vehicle_nodes; node++) {
-      node_index_to_incoming_neighbors_by_cost_class_[cc][node].reserve(
-          num_neighbors + routing_model_.vehicles());
-      if (node < size) {
-        node_index_to_outgoing_neighbors_by_cost_class_[cc][node].reserve(
-            num_neighbors + routing_model_.vehicles());
-        node_index_to_outgoing_neighbor_indicator_by_cost_class_[cc][node]
-            .resize(size_with_vehicle_nodes, false);
-        node_index_to_outgoing_costs_by_cost_class[cc][node].resize(
-            size_with_vehicle_nodes, -1);
-      }
+      cost_classes.push_back(cc);
     }
   }
-
-  std::vector<int> outgoing_neighbors;
-  for (int cost_class = 0; cost_class < num_cost_classes; cost_class++) {
-    if (!routing_model_.HasVehicleWithCostClassIndex(
-            RoutingCostClassIndex(cost_class))) {
-      // No vehicle with this cost class, avoid unnecessary computations.
-      continue;
-    }
-    std::vector<std::vector<int>>& node_index_to_incoming_neighbors =
-        node_index_to_incoming_neighbors_by_cost_class_[cost_class];
-    std::vector<std::vector<int>>& node_index_to_outgoing_neighbors =
-        node_index_to_outgoing_neighbors_by_cost_class_[cost_class];
-    std::vector<std::vector<bool>>& node_index_to_outgoing_neighbor_indicator =
-        node_index_to_outgoing_neighbor_indicator_by_cost_class_[cost_class];
-    std::vector<std::vector<int64_t>>& node_index_to_outgoing_costs =
-        node_index_to_outgoing_costs_by_cost_class[cost_class];
-    for (int node_index = 0; node_index < size; ++node_index) {
-      if (routing_model_.IsStart(node_index)) {
-        // For vehicle start/ends, we consider all nodes (see below).
-        continue;
-      }
-
-      // TODO(user): Use the model's IndexNeighborFinder when available.
-      outgoing_neighbors.clear();
-      outgoing_neighbors.reserve(num_non_start_end_nodes);
-      if (num_neighbors > 0) {
-        std::vector<int64_t>& costs = node_index_to_outgoing_costs[node_index];
-        for (int after_node = 0; after_node < size; ++after_node) {
-          if (after_node != node_index && !routing_model_.IsStart(after_node)) {
-            costs[after_node] = routing_model_.GetArcCostForClass(
-                node_index, after_node, cost_class);
-            outgoing_neighbors.push_back(after_node);
+  node_index_to_incoming_neighbors_by_cost_class_.resize(num_cost_classes);
+  node_index_to_outgoing_neighbors_by_cost_class_.resize(num_cost_classes);
+  node_index_to_outgoing_neighbor_indicator_by_cost_class_.resize(
+      num_cost_classes);
+  indicator_row_size_ = (size_with_vehicle_nodes + 63) / 64 * 64;
+  for (const int cc : cost_classes) {
+    node_index_to_outgoing_neighbor_indicator_by_cost_class_[cc]
+        .ClearAndResize(size * indicator_row_size_);
+  }
+
+  // The candidate neighbors of a node are all the other non-start nodes, or
+  // their nearest ones in the plane when coordinates are available.
+  const std::vector<std::pair<int64_t, int64_t>>& coordinates =
+      routing_model_.index_coordinates_;
+  std::unique_ptr<PointKdTree> kd_tree;
+  const int num_kd_tree_candidates = std::min<int64_t>(
+      num_non_start_end_nodes,
+      int64_t{kNeighborCandidatesPerNeighbor} * num_neighbors + 1);
+  if (!coordinates.empty() && num_neighbors > 0) {
+    std::vector<int> candidates;
+    candidates.reserve(num_non_start_end_nodes);
+    for (int node = 0; node < size; ++node) {
+      if (!routing_model_.IsStart(node)) candidates.push_back(node);
+    }
+    kd_tree = std::make_unique<PointKdTree>(coordinates, std::move(candidates));
+  }
+
+  // outgoing_by_cost_class[cost_class][node] holds the (cost, neighbor) pairs
+  // of the outgoing neighbors of node. Only the selected neighbors are stored,
+  // instead of the cost of all arcs. The rows of the nodes are independent,
+  // which allows filling them in parallel, all cost classes of a node being
+  // computed by the same thread since the arc cost cache is per node.
+  using CostAndNeighbor = std::pair<int64_t, int>;
+  std::vector<std::vector<std::vector<CostAndNeighbor>>>
+      outgoing_by_cost_class(num_cost_classes);
+  for (const int cc : cost_classes) outgoing_by_cost_class[cc].resize(size);
+  RunOnBlocks(
+      size, routing_model_.num_threads_for_node_neighbors_,
+      [&](int begin, int end) {
+        std::vector<int> candidates;
+        for (int node_index = begin; node_index < end; ++node_index) {
+          // For vehicle start/ends, we consider all nodes (see below).
+          if (routing_model_.IsStart(node_index)) continue;
+          if (num_neighbors == 0) continue;
+          if (kd_tree != nullptr) {
+            const auto& [x, y] = coordinates[node_index];
+            kd_tree->FindNearest(x, y, num_kd_tree_candidates, &candidates);
+          }
+          for (const int cost_class : cost_classes) {
+            std::vector<CostAndNeighbor>& neighbors =
+                outgoing_by_cost_class[cost_class][node_index];
+            const auto add_candidate = [&](int after_node) {
+              neighbors.push_back({routing_model_.GetArcCostForClass(
+                                       node_index, after_node, cost_class),
+                                   after_node});
+            };
+            if (kd_tree != nullptr) {
+              neighbors.reserve(candidates.size());
+              for (const int after_node : candidates) {
+                if (after_node != node_index) add_candidate(after_node);
+              }
+            } else {
+              neighbors.reserve(num_non_start_end_nodes);
+              for (int after_node = 0; after_node < size; ++after_node) {
+                if (after_node != node_index &&
+                    !routing_model_.IsStart(after_node)) {
+                  add_candidate(after_node);
+                }
+              }
+            }
+            // Get the 'num_neighbors' closest neighbors.
+            DCHECK_GE(neighbors.size(), num_neighbors);
+            std::nth_element(neighbors.begin(),
+                             neighbors.begin() + num_neighbors - 1,
+                             neighbors.end());
+            neighbors.resize(num_neighbors);
+            neighbors.shrink_to_fit();
+            Bitset64<int64_t>& indicator =
+                node_index_to_outgoing_neighbor_indicator_by_cost_class_
+                    [cost_class];
+            for (const auto& [cost, neighbor] : neighbors) {
+              DCHECK(!routing_model_.IsEnd(neighbor) &&
+                     !routing_model_.IsStart(neighbor));
+              indicator.Set(node_index * indicator_row_size_ + neighbor);
+            }
           }
         }
-        // Get the 'num_neighbors' closest neighbors.
-        DCHECK_GE(outgoing_neighbors.size(), num_neighbors);
-        std::nth_element(outgoing_neighbors.begin(),
-                         outgoing_neighbors.begin() + num_neighbors - 1,
-                         outgoing_neighbors.end(), [&costs](int n1, int n2) {
-                           return std::tie(costs[n1], n1) <
-                                  std::tie(costs[n2], n2);
-                         });
-        outgoing_neighbors.resize(num_neighbors);
-      }
+      });
 
-      // Add neighborhoods.
-      for (int outgoing_neighbor : outgoing_neighbors) {
-        DCHECK(!routing_model_.IsEnd(outgoing_neighbor) &&
-               !routing_model_.IsStart(outgoing_neighbor));
-        DCHECK(!node_index_to_outgoing_neighbor_indicator[node_index]
-                                                         [outgoing_neighbor]);
-        node_index_to_outgoing_neighbor_indicator[node_index]
-                                                 [outgoing_neighbor] = true;
-        node_index_to_outgoing_neighbors[node_index].push_back(
-            outgoing_neighbor);
-        // node_index is an incoming neighbor of outgoing_neighbor.
-        node_index_to_incoming_neighbors[outgoing_neighbor].push_back(
-            node_index);
+  for (const int cost_class : cost_classes) {
+    std::vector<std::vector<CostAndNeighbor>>& outgoing =
+        outgoing_by_cost_class[cost_class];
+    std::vector<std::vector<CostAndNeighbor>> incoming(
+        size_with_vehicle_nodes);
+    for (int node_index = 0; node_index < size; ++node_index) {
+      for (const auto& [cost, neighbor] : outgoing[node_index]) {
+        // node_index is an incoming neighbor of neighbor.
+        incoming[neighbor].push_back({cost, node_index});
       }
     }
-  }
 
-  // Add all vehicle start/ends as incoming/outgoing neighbors for all nodes.
-  for (int cost_class = 0; cost_class < num_cost_classes; cost_class++) {
-    if (!routing_model_.HasVehicleWithCostClassIndex(
-            RoutingCostClassIndex(cost_class))) {
-      // No vehicle with this cost class, avoid unnecessary computations.
-      continue;
-    }
-    std::vector<std::vector<int>>& node_index_to_incoming_neighbors =
-        node_index_to_incoming_neighbors_by_cost_class_[cost_class];
-    std::vector<std::vector<int>>& node_index_to_outgoing_neighbors =
-        node_index_to_outgoing_neighbors_by_cost_class_[cost_class];
-    std::vector<std::vector<bool>>& node_index_to_outgoing_neighbor_indicator =
+    // Add all vehicle start/ends as incoming/outgoing neighbors for all nodes.
+    Bitset64<int64_t>& indicator =
         node_index_to_outgoing_neighbor_indicator_by_cost_class_[cost_class];
-    std::vector<std::vector<int64_t>>& node_index_to_outgoing_costs =
-        node_index_to_outgoing_costs_by_cost_class[cost_class];
+    const auto set_neighborhood_arc = [this, &indicator](int64_t from,
+                                                         int64_t to) {
+      DCHECK(!indicator[from * indicator_row_size_ + to]);
+      indicator.Set(from * indicator_row_size_ + to);
+    };
     for (int vehicle = 0; vehicle < routing_model_.vehicles(); vehicle++) {
       const int vehicle_start = routing_model_.Start(vehicle);
       const int vehicle_end = routing_model_.End(vehicle);
 
       // Mark vehicle_start -> vehicle_end as a neighborhood arc.
-      DCHECK(!node_index_to_outgoing_neighbor_indicator[vehicle_start]
-                                                       [vehicle_end]);
-      node_index_to_outgoing_neighbor_indicator[vehicle_start][vehicle_end] =
-          true;
+      set_neighborhood_arc(vehicle_start, vehicle_end);
+      const int64_t start_end_cost = routing_model_.GetArcCostForClass(
+          vehicle_start, vehicle_end, cost_class);
       if (add_vehicle_starts_to_neighbors) {
-        node_index_to_incoming_neighbors[vehicle_end].push_back(vehicle_start);
+        incoming[vehicle_end].push_back({start_end_cost, vehicle_start});
       }
       if (add_vehicle_ends_to_neighbors) {
-        node_index_to_outgoing_neighbors[vehicle_start].push_back(vehicle_end);
+        outgoing[vehicle_start].push_back({start_end_cost, vehicle_end});
       }
-      node_index_to_outgoing_costs[vehicle_start][vehicle_end] =
-          routing_model_.GetArcCostForClass(vehicle_start, vehicle_end,
-                                            cost_class);
 
       for (int node_index = 0; node_index < size; ++node_index) {
         if (routing_model_.IsStart(node_index)) continue;
 
         // Mark vehicle_start -> node_index as a neighborhood arc.
-        DCHECK(!node_index_to_outgoing_neighbor_indicator[node_index]
-                                                         [vehicle_start]);
-        DCHECK(!node_index_to_outgoing_neighbor_indicator[vehicle_start]
-                                                         [node_index]);
-        node_index_to_outgoing_neighbor_indicator[vehicle_start][node_index] =
-            true;
+        DCHECK(!indicator[node_index * indicator_row_size_ + vehicle_start]);
+        set_neighborhood_arc(vehicle_start, node_index);
+        const int64_t start_cost = routing_model_.GetArcCostForClass(
+            vehicle_start, node_index, cost_class);
         if (add_vehicle_starts_to_neighbors) {
-          node_index_to_incoming_neighbors[node_index].push_back(vehicle_start);
+          incoming[node_index].push_back({start_cost, vehicle_start});
         }
-        node_index_to_outgoing_neighbors[vehicle_start].push_back(node_index);
-        node_index_to_outgoing_costs[vehicle_start][node_index] =
-            routing_model_.GetArcCostForClass(vehicle_start, node_index,
-                                              cost_class);
+        outgoing[vehicle_start].push_back({start_cost, node_index});
 
         // Mark node_index -> vehicle_end as a neighborhood arc.
-        DCHECK(!node_index_to_outgoing_neighbor_indicator[node_index]
-                                                         [vehicle_end]);
-        node_index_to_outgoing_neighbor_indicator[node_index][vehicle_end] =
-            true;
-        node_index_to_incoming_neighbors[vehicle_end].push_back(node_index);
+        set_neighborhood_arc(node_index, vehicle_end);
+        const int64_t end_cost = routing_model_.GetArcCostForClass(
+            node_index, vehicle_end, cost_class);
+        incoming[vehicle_end].push_back({end_cost, node_index});
         if (add_vehicle_ends_to_neighbors) {
-          node_index_to_outgoing_neighbors[node_index].push_back(vehicle_end);
+          outgoing[node_index].push_back({end_cost, vehicle_end});
         }
-        node_index_to_outgoing_costs[node_index][vehicle_end] =
-            routing_model_.GetArcCostForClass(node_index, vehicle_end,
-                                              cost_class);
       }
     }
-  }
 
-  // Sort the neighbors into
-  // node_index_to_{incoming,outgoing}_neighbors_by_cost_class_ by cost.
-  for (int cost_class = 0; cost_class < num_cost_classes; cost_class++) {
-    if (!routing_model_.HasVehicleWithCostClassIndex(
-            RoutingCostClassIndex(cost_class))) {
-      // No vehicle with this cost class.
-      continue;
-    }
-    const std::vector<std::vector<int64_t>>& node_index_to_outgoing_costs =
-        node_index_to_outgoing_costs_by_cost_class[cost_class];
+    // Sort the neighbors into
+    // node_index_to_{incoming,outgoing}_neighbors_by_cost_class_ by cost.
+    const auto sorted_neighbors = [](std::vector<CostAndNeighbor>& neighbors) {
+      absl::c_sort(neighbors);
+      std::vector<int> sorted;
+      sorted.reserve(neighbors.size());
+      for (const auto& [cost, neighbor] : neighbors) sorted.push_back(neighbor);
+      // Check that there are no duplicate elements.
+      DCHECK(absl::c_adjacent_find(sorted) == sorted.end());
+      neighbors.clear();
+      neighbors.shrink_to_fit();
+      return sorted;
+    };
+    std::vector<std::vector<int>>& node_index_to_incoming_neighbors =
+        node_index_to_incoming_neighbors_by_cost_class_[cost_class];
+    std::vector<std::vector<int>>& node_index_to_outgoing_neighbors =
+        node_index_to_outgoing_neighbors_by_cost_class_[cost_class];
+    node_index_to_incoming_neighbors.resize(size_with_vehicle_nodes);
+    node_index_to_outgoing_neighbors.resize(size);
     for (int node_index = 0; node_index < size_with_vehicle_nodes;
          ++node_index) {
-      std::vector<int>& incoming_node_neighbors =
-          node_index_to_incoming_neighbors_by_cost_class_[cost_class]
-                                                         [node_index];
-      absl::c_sort(
-          incoming_node_neighbors,
-          [node_index, size, &node_index_to_outgoing_costs](int n1, int n2) {
-            DCHECK_GE(node_index_to_outgoing_costs[n1][node_index], 0);
-            DCHECK_GE(node_index_to_outgoing_costs[n2][node_index], 0);
-            DCHECK_LT(n1, size);
-            DCHECK_LT(n2, size);
-            return std::tie(node_index_to_outgoing_costs[n1][node_index], n1) <
-                   std::tie(node_index_to_outgoing_costs[n2][node_index], n2);
-          });
-      // Check that there are no duplicate elements.
-      DCHECK(absl::c_adjacent_find(incoming_node_neighbors) ==
-             incoming_node_neighbors.end());
-
+      node_index_to_incoming_neighbors[node_index] =
+          sorted_neighbors(incoming[node_index]);
       if (node_index < size) {
-        std::vector<int>& outgoing_node_neighbors =
-            node_index_to_outgoing_neighbors_by_cost_class_[cost_class]
-                                                           [node_index];
-        const std::vector<int64_t>& outgoing_costs =
-            node_index_to_outgoing_costs[node_index];
-        absl::c_sort(outgoing_node_neighbors,
-                     [&outgoing_costs](int n1, int n2) {
-                       DCHECK_GE(outgoing_costs[n1], 0);
-                       DCHECK_GE(outgoing_costs[n2], 0);
-                       return std::tie(outgoing_costs[n1], n1) <
-                              std::tie(outgoing_costs[n2], n2);
-                     });
-
-        // Check that there are no duplicate elements.
-        DCHECK(absl::c_adjacent_find(outgoing_node_neighbors) ==
-               outgoing_node_neighbors.end());
+        node_index_to_outgoing_neighbors[node_index] =
+            sorted_neighbors(outgoing[node_index]);
       }
     }
   }
@@ -565,6 +585,10 @@ RoutingModel::RoutingModel(const RoutingIndexManager& index_manager,
   // Active caching after initializing vehicle_to_transit_cost_ to avoid
   // uselessly caching ReturnZero.
   cache_callbacks_ = (nodes_ <= parameters.max_callback_cache_size());
+  num_threads_for_node_neighbors_ =
+      std::max(1, parameters.num_threads_for_node_neighbors());
+  max_arc_cost_table_memory_bytes_ =
+      parameters.max_arc_cost_table_memory_bytes();
 
   // TODO(user): Remove when removal of NodeIndex is complete.
   start_end_count_ = index_manager.num_unique_depots();
@@ -609,6 +633,7 @@ void RoutingModel::Initialize() {
   cost_cache_.clear();
   cost_cache_.resize(size + vehicles_, {kUnassigned, CostClassIndex(-1), 0});
   preassignment_ = solver_->MakeAssignment();
+  next_solves_updates_ = solver_->MakeAssignment();
 }
 
 RoutingModel::~RoutingModel() {
@@ -656,28 +681,33 @@ int RoutingModel::RegisterUnaryTransitCallback(TransitCallback1 callback,
 
 int RoutingModel::RegisterTransitMatrix(
     std::vector<std::vector<int64_t> /*needed_for_swig*/> values) {
-  // TODO(user): when we move away from std::functions, use a (potentially
-  // vectorized) helper to compute the sign of a range.
-  bool all_transits_geq_zero = true;
-  bool all_transits_leq_zero = true;
-  for (const std::vector<int64_t>& transit_values : values) {
-    for (const int64_t value : transit_values) {
-      all_transits_leq_zero &= value <= 0;
-      all_transits_geq_zero &= value >= 0;
-    }
-    if (!all_transits_geq_zero && !all_transits_leq_zero) break;
+  return RegisterCompactTransitMatrix(
+      std::make_unique<RoutingTransitMatrix>(values));
+}
+
+int RoutingModel::RegisterCompactTransitMatrix(
+    std::unique_ptr<RoutingTransitMatrix> matrix) {
+  const int size = Size() + vehicles();
+  std::vector<int> index_to_node(size);
+  for (int i = 0; i < size; ++i) {
+    index_to_node[i] = manager_.IndexToNode(i).value();
+    CHECK_LT(index_to_node[i], matrix->num_nodes());
   }
+  matrix->SetIndexToNode(std::move(index_to_node));
   const TransitEvaluatorSign sign =
-      all_transits_geq_zero
+      matrix->min_value() >= 0
           ? kTransitEvaluatorSignPositiveOrZero
-          : (all_transits_leq_zero ? kTransitEvaluatorSignNegativeOrZero
-                                   : kTransitEvaluatorSignUnknown);
-  return RegisterTransitCallback(
-      [this, values = std::move(values)](int64_t i, int64_t j) {
-        return values[manager_.IndexToNode(i).value()]
-                     [manager_.IndexToNode(j).value()];
-      },
-      sign);
+          : (matrix->max_value() <= 0 ? kTransitEvaluatorSignNegativeOrZero
+                                      : kTransitEvaluatorSignUnknown);
+  // The matrix is already compact, there is no need to cache it.
+  const RoutingTransitMatrix* const matrix_ptr = matrix.get();
+  transit_evaluators_.push_back([matrix_ptr](int64_t i, int64_t j) {
+    return matrix_ptr->Evaluate(i, j);
+  });
+  unary_transit_evaluators_.push_back(nullptr);
+  transit_evaluator_sign_.push_back(sign);
+  transit_matrices_.push_back(std::move(matrix));
+  return transit_evaluators_.size() - 1;
 }
 
 int RoutingModel::RegisterTransitCallback(TransitCallback2 callback,
@@ -714,6 +744,7 @@ int RoutingModel::RegisterTransitCallback(TransitCallback2 callback,
     unary_transit_evaluators_.push_back(nullptr);
   }
   transit_evaluator_sign_.push_back(sign);
+  transit_matrices_.push_back(nullptr);
   return transit_evaluators_.size() - 1;
 }
 
@@ -2509,6 +2540,7 @@ void RoutingModel::CloseModelWithParameters(
   // CloseModel() on dimensions and *before* ComputeVehicleClasses().
   FinalizeAllowedVehicles();
   ComputeCostClasses(parameters);
+  ComputeArcCostTable();
   ComputeVehicleClasses();
   ComputeVehicleTypes();
   ComputeResourceClasses();
@@ -3420,6 +3452,293 @@ const Assignment* RoutingModel::SolveFromAssignmentsWithParameters(
 
 const Assignment* RoutingModel::SolveWithIteratedLocalSearch(
     const RoutingSearchParameters& parameters) {
+  return SolveWithIteratedLocalSearchInternal(parameters, /*worker=*/0,
+                                              /*pool=*/nullptr);
+}
+
+const Assignment* RoutingModel::SolveWithParallelIteratedLocalSearch(
+    absl::Span<RoutingModel* const> models,
+    const RoutingSearchParameters& parameters) {
+  CHECK(!models.empty());
+  const int num_workers = models.size();
+  SharedRoutingSolutionPool pool(num_workers);
+  std::vector<const Assignment*> solutions(num_workers, nullptr);
+  {
+    ThreadPool thread_pool(num_workers);
+    thread_pool.StartWorkers();
+    for (int worker = 0; worker < num_workers; ++worker) {
+      thread_pool.Schedule([&models, &parameters, &pool, &solutions, worker]() {
+        RoutingModel* const model = models[worker];
+        solutions[worker] = model->SolveWithIteratedLocalSearchInternal(
+            parameters, worker, &pool);
+        pool.WorkerDone();
+      });
+    }
+  }
+
+  int best_worker = -1;
+  for (int worker = 0; worker < num_workers; ++worker) {
+    if (solutions[worker] == nullptr) continue;
+    if (best_worker < 0 || solutions[worker]->ObjectiveValue() <
+                               solutions[best_worker]->ObjectiveValue()) {
+      best_worker = worker;
+    }
+  }
+  if (best_worker <= 0) return best_worker < 0 ? nullptr : solutions[0];
+  RoutingModel* const model = models[0];
+  Assignment* const solution = model->solver()->MakeAssignment();
+  model->SetAssignmentFromOtherModelAssignment(solution, models[best_worker],
+                                               solutions[best_worker]);
+  return model->RestoreAssignment(*solution);
+}
+
+namespace {
+// Partitions [0, num_routes) into groups of at most group_size routes: each
+// group is made of a random route and of the closest remaining routes.
+std::vector<std::vector<int>> PartitionRoutes(
+    int num_routes, int group_size,
+    const std::function<double(int, int)>& route_distance,
+    std::mt19937* rnd) {
+  std::vector<int> order(num_routes);
+  absl::c_iota(order, 0);
+  std::shuffle(order.begin(), order.end(), *rnd);
+  std::vector<bool> grouped(num_routes, false);
+  std::vector<std::vector<int>> groups;
+  std::vector<std::pair<double, int>> candidates;
+  for (const int seed : order) {
+    if (grouped[seed]) continue;
+    grouped[seed] = true;
+    std::vector<int>& group = groups.emplace_back(1, seed);
+    candidates.clear();
+    for (int route = 0; route < num_routes; ++route) {
+      if (grouped[route]) continue;
+      candidates.push_back({route_distance(seed, route), route});
+    }
+    const int num_added =
+        std::min<int>(group_size - 1, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + num_added,
+                      candidates.end());
+    for (int i = 0; i < num_added; ++i) {
+      grouped[candidates[i].second] = true;
+      group.push_back(candidates[i].second);
+    }
+  }
+  return groups;
+}
+}  // namespace
+
+const Assignment* RoutingModel::SolveWithRouteDecomposition(
+    absl::Span<RoutingModel* const> models,
+    const RoutingSearchParameters& parameters) {
+  CHECK(!models.empty());
+  RoutingModel* const model = models[0];
+  const RoutingSearchParameters::RouteDecompositionParameters& decomposition =
+      parameters.route_decomposition_parameters();
+  const int64_t start_time_ms = model->solver()->wall_time();
+  const auto time_left = [model, start_time_ms, &parameters]() {
+    return GetTimeLimit(parameters) -
+           absl::Milliseconds(model->solver()->wall_time() - start_time_ms);
+  };
+
+  RoutingSearchParameters first_solution_parameters = parameters;
+  first_solution_parameters.set_solution_limit(1);
+  const Assignment* const first_solution =
+      model->SolveWithParameters(first_solution_parameters);
+  if (first_solution == nullptr) return nullptr;
+  Assignment* const best_solution =
+      model->solver()->MakeAssignment(first_solution);
+
+  const int num_workers = models.size();
+  const int num_vehicles = model->vehicles();
+  const int size = model->Size();
+  std::vector<Assignment*> start_assignments(num_workers);
+  for (int worker = 0; worker < num_workers; ++worker) {
+    start_assignments[worker] = models[worker]->solver()->MakeAssignment();
+  }
+  std::mt19937 rnd(/*seed=*/0);
+  std::vector<std::vector<int64_t>> routes;
+  std::vector<std::pair<double, double>> centroids(num_vehicles);
+  for (int round = 0;
+       decomposition.max_rounds() == 0 || round < decomposition.max_rounds();
+       ++round) {
+    const absl::Duration remaining_time = time_left();
+    if (remaining_time <= absl::ZeroDuration()) break;
+    RoutingSearchParameters subproblem_parameters = parameters;
+    util_time::EncodeGoogleApiProto(
+        std::min(remaining_time, util_time::DecodeGoogleApiProto(
+                                     decomposition.subproblem_time_limit())
+                                     .value()),
+        subproblem_parameters.mutable_time_limit())
+        .IgnoreError();
+
+    // Partition the routes, represented by the centroid of their indices if
+    // there are coordinates, and by their first index otherwise.
+    model->AssignmentToRoutes(*best_solution, &routes);
+    const bool has_coordinates = !model->index_coordinates_.empty();
+    const auto representative = [model, &routes](int vehicle) {
+      return routes[vehicle].empty() ? model->Start(vehicle)
+                                     : routes[vehicle][0];
+    };
+    if (has_coordinates) {
+      for (int vehicle = 0; vehicle < num_vehicles; ++vehicle) {
+        const auto [x, y] = model->index_coordinates_[model->Start(vehicle)];
+        double sum_x = x;
+        double sum_y = y;
+        for (const int64_t index : routes[vehicle]) {
+          sum_x += model->index_coordinates_[index].first;
+          sum_y += model->index_coordinates_[index].second;
+        }
+        const double num_indices = routes[vehicle].size() + 1;
+        centroids[vehicle] = {sum_x / num_indices, sum_y / num_indices};
+      }
+    }
+    // Distance from the route of 'vehicle' to 'index'.
+    const auto distance_to_index = [model, has_coordinates, &centroids,
+                                    &representative](int vehicle,
+                                                     int64_t index) {
+      if (!has_coordinates) {
+        return static_cast<double>(model->GetArcCostForVehicle(
+            representative(vehicle), index, vehicle));
+      }
+      const auto [x, y] = model->index_coordinates_[index];
+      const double dx = centroids[vehicle].first - x;
+      const double dy = centroids[vehicle].second - y;
+      return dx * dx + dy * dy;
+    };
+    const std::vector<std::vector<int>> groups = PartitionRoutes(
+        num_vehicles, decomposition.num_routes_per_subproblem(),
+        [&](int vehicle1, int vehicle2) {
+          if (!has_coordinates) {
+            return distance_to_index(vehicle1, representative(vehicle2));
+          }
+          const auto [x1, y1] = centroids[vehicle1];
+          const auto [x2, y2] = centroids[vehicle2];
+          const double dx = x1 - x2;
+          const double dy = y1 - y2;
+          return dx * dx + dy * dy;
+        },
+        &rnd);
+    const int num_groups = groups.size();
+
+    // Assign each unperformed index to the group of the closest seed route;
+    // the alternatives of a pickup and delivery pair go to the same group.
+    std::vector<bool> performed(size, false);
+    for (const std::vector<int64_t>& route : routes) {
+      for (const int64_t index : route) performed[index] = true;
+    }
+    std::vector<int> group_of_unperformed(size, -1);
+    for (int64_t index = 0; index < size; ++index) {
+      if (performed[index] || model->IsStart(index)) continue;
+      int64_t anchor = index;
+      std::optional<PickupDeliveryPosition> position =
+          model->GetPickupPosition(index);
+      if (!position.has_value()) position = model->GetDeliveryPosition(index);
+      if (position.has_value()) {
+        anchor = model->GetPickupAndDeliveryPairs()[position->pd_pair_index]
+                     .pickup_alternatives[0];
+        if (anchor != index && !performed[anchor] &&
+            group_of_unperformed[anchor] >= 0) {
+          group_of_unperformed[index] = group_of_unperformed[anchor];
+          continue;
+        }
+      }
+      double best_distance = std::numeric_limits<double>::infinity();
+      for (int group = 0; group < num_groups; ++group) {
+        const double distance = distance_to_index(groups[group][0], anchor);
+        if (distance < best_distance) {
+          best_distance = distance;
+          group_of_unperformed[index] = group;
+        }
+      }
+    }
+
+    // Optimize the groups in parallel, worker w handling the groups g with
+    // g % num_workers == w.
+    std::vector<std::optional<std::vector<std::vector<int64_t>>>> group_routes(
+        num_groups);
+    {
+      ThreadPool thread_pool(std::min(num_workers, num_groups));
+      thread_pool.StartWorkers();
+      for (int worker = 0; worker < std::min(num_workers, num_groups);
+           ++worker) {
+        thread_pool.Schedule([&, worker]() {
+          RoutingModel* const worker_model = models[worker];
+          // Only models[0] was closed by the first solution search.
+          worker_model->QuietCloseModelWithParameters(subproblem_parameters);
+          Assignment* const locks = worker_model->MutablePreAssignment();
+          // The locks set by the caller are kept in every subproblem, and
+          // restored once the worker is done.
+          const Assignment* const caller_locks =
+              worker_model->solver()->MakeAssignment(locks);
+          std::vector<bool> vehicle_in_group(num_vehicles);
+          for (int group = worker; group < num_groups; group += num_workers) {
+            // Lock the routes of the other groups and their unperformed
+            // indices.
+            locks->Copy(caller_locks);
+            vehicle_in_group.assign(num_vehicles, false);
+            for (const int vehicle : groups[group]) {
+              vehicle_in_group[vehicle] = true;
+            }
+            for (int vehicle = 0; vehicle < num_vehicles; ++vehicle) {
+              if (vehicle_in_group[vehicle]) continue;
+              int64_t previous = worker_model->Start(vehicle);
+              for (const int64_t index : routes[vehicle]) {
+                locks->Add(worker_model->NextVar(previous));
+                locks->SetValue(worker_model->NextVar(previous), index);
+                previous = index;
+              }
+              locks->Add(worker_model->NextVar(previous));
+              locks->SetValue(worker_model->NextVar(previous),
+                              worker_model->End(vehicle));
+            }
+            for (int64_t index = 0; index < size; ++index) {
+              if (performed[index] || worker_model->IsStart(index) ||
+                  group_of_unperformed[index] == group) {
+                continue;
+              }
+              locks->Add(worker_model->NextVar(index));
+              locks->SetValue(worker_model->NextVar(index), index);
+            }
+            Assignment* const start = start_assignments[worker];
+            if (!worker_model->RoutesToAssignment(
+                    routes, /*ignore_inactive_indices=*/true,
+                    /*close_routes=*/true, start)) {
+              continue;
+            }
+            const Assignment* const solution =
+                worker_model->SolveFromAssignmentWithParameters(
+                    start, subproblem_parameters);
+            if (solution == nullptr) continue;
+            worker_model->AssignmentToRoutes(*solution,
+                                             &group_routes[group].emplace());
+          }
+          locks->Copy(caller_locks);
+        });
+      }
+    }
+
+    // Merge the routes of the groups.
+    for (int group = 0; group < num_groups; ++group) {
+      if (!group_routes[group].has_value()) continue;
+      for (const int vehicle : groups[group]) {
+        routes[vehicle] = std::move((*group_routes[group])[vehicle]);
+      }
+    }
+    const Assignment* const merged_solution =
+        model->ReadAssignmentFromRoutes(routes,
+                                        /*ignore_inactive_indices=*/true);
+    if (merged_solution == nullptr ||
+        merged_solution->ObjectiveValue() >= best_solution->ObjectiveValue()) {
+      break;
+    }
+    best_solution->Copy(merged_solution);
+  }
+  return model->RestoreAssignment(*best_solution);
+}
+
+const Assignment* RoutingModel::SolveWithIteratedLocalSearchInternal(
+    const RoutingSearchParameters& parameters, int worker,
+    SharedRoutingSolutionPool* pool) {
   DCHECK(parameters.use_iterated_local_search());
 
   if (nodes() == 0) {
@@ -3450,7 +3769,7 @@ const Assignment* RoutingModel::SolveWithIteratedLocalSearch(
                                           {/*filter_objective=*/false,
                                            /*filter_with_cp_solver=*/false});
 
-  std::mt19937 rnd(/*seed=*/0);
+  std::mt19937 rnd(/*seed=*/worker);
 
   DecisionBuilder* perturbation_db = MakePerturbationDecisionBuilder(
       parameters, this, &rnd, last_accepted_solution,
@@ -3480,9 +3799,41 @@ const Assignment* RoutingModel::SolveWithIteratedLocalSearch(
   std::unique_ptr<NeighborAcceptanceCriterion> acceptance_criterion =
       MakeNeighborAcceptanceCriterion(*this, parameters, &rnd);
 
+  const IteratedLocalSearchParameters& ils_parameters =
+      parameters.iterated_local_search_parameters();
   const bool improve_perturbed_solution =
-      parameters.iterated_local_search_parameters()
-          .improve_perturbed_solution();
+      ils_parameters.improve_perturbed_solution();
+
+  // Shares best_solution with the other workers, and replaces it and
+  // last_accepted_solution by the best solution of the pool if it is better.
+  // In deterministic mode, all the workers offer their solution before any of
+  // them reads the pool, and read the pool before any of them offers again.
+  const int64_t num_perturbations_between_sharing = std::max<int64_t>(
+      1, ils_parameters.num_perturbations_between_solution_sharing());
+  const bool deterministic_sharing =
+      ils_parameters.deterministic_solution_sharing();
+  int64_t num_perturbations = 0;
+  int64_t last_shared_objective = std::numeric_limits<int64_t>::max();
+  std::vector<std::vector<int64_t>> shared_routes;
+  const auto share_solutions = [&]() {
+    if (deterministic_sharing) pool->SynchronizeWorkers();
+    if (best_solution->ObjectiveValue() < last_shared_objective) {
+      last_shared_objective = best_solution->ObjectiveValue();
+      AssignmentToRoutes(*best_solution, &shared_routes);
+      pool->Offer(worker, last_shared_objective, std::move(shared_routes));
+    }
+    if (deterministic_sharing) pool->SynchronizeWorkers();
+    if (!pool->GetBestIfBetter(best_solution->ObjectiveValue(),
+                               &shared_routes)) {
+      return;
+    }
+    const Assignment* const shared_solution = ReadAssignmentFromRoutes(
+        shared_routes, /*ignore_inactive_indices=*/false);
+    if (shared_solution == nullptr) return;
+    best_solution->CopyIntersection(shared_solution);
+    last_accepted_solution->CopyIntersection(shared_solution);
+    last_shared_objective = best_solution->ObjectiveValue();
+  };
 
   while (update_time_limits() &&
          explored_solutions < parameters.solution_limit()) {
@@ -3521,6 +3872,11 @@ const Assignment* RoutingModel::SolveWithIteratedLocalSearch(
       // also keep the perturbation_db reference assignment up to date.
       last_accepted_solution->CopyIntersection(neighbor_solution);
     }
+
+    if (pool != nullptr &&
+        ++num_perturbations % num_perturbations_between_sharing == 0) {
+      share_solutions();
+    }
   }
 
   return best_solution;
@@ -3827,6 +4183,113 @@ bool RoutingModel::ApplyLocksToAllVehicles(
   return RoutesToAssignment(locks, true, close_routes, preassignment_);
 }
 
+void RoutingModel::SetIndexDeactivatedForNextSolves(int64_t index,
+                                                    bool deactivated) {
+  CHECK_GE(index, 0);
+  CHECK_LT(index, Size()) << "Vehicle ends cannot be deactivated";
+  CHECK(!IsStart(index)) << "Vehicle starts cannot be deactivated";
+  CHECK(!GetDisjunctionIndices(index).empty())
+      << "Only the optional indices, in disjunctions, can be deactivated";
+  IntVar* const active_var = ActiveVar(index);
+  if (deactivated) {
+    next_solves_updates_->Add(active_var);
+    next_solves_updates_->SetValue(active_var, 0);
+    next_solves_updates_->Activate(active_var);
+  } else if (next_solves_updates_->Contains(active_var)) {
+    next_solves_updates_->Deactivate(active_var);
+  }
+  ++next_solves_updates_stamp_;
+}
+
+bool RoutingModel::IsIndexDeactivatedForNextSolves(int64_t index) const {
+  const IntVar* const active_var = ActiveVar(index);
+  return next_solves_updates_->Contains(active_var) &&
+         next_solves_updates_->Activated(active_var);
+}
+
+void RoutingModel::SetCumulRangeForNextSolves(
+    const RoutingDimension& dimension, int64_t index, int64_t min,
+    int64_t max) {
+  IntVar* const cumul_var = dimension.CumulVar(index);
+  next_solves_updates_->Add(cumul_var);
+  next_solves_updates_->SetRange(cumul_var, min, max);
+  next_solves_updates_->Activate(cumul_var);
+  ++next_solves_updates_stamp_;
+}
+
+void RoutingModel::ClearCumulRangeForNextSolves(
+    const RoutingDimension& dimension, int64_t index) {
+  IntVar* const cumul_var = dimension.CumulVar(index);
+  if (next_solves_updates_->Contains(cumul_var)) {
+    next_solves_updates_->Deactivate(cumul_var);
+  }
+  ++next_solves_updates_stamp_;
+}
+
+int64_t RoutingModel::GetCumulMinForNextSolves(
+    const RoutingDimension& dimension, int64_t index) const {
+  const IntVar* const cumul_var = dimension.CumulVar(index);
+  return next_solves_updates_->Contains(cumul_var) &&
+                 next_solves_updates_->Activated(cumul_var)
+             ? next_solves_updates_->Min(cumul_var)
+             : kint64min;
+}
+
+int64_t RoutingModel::GetCumulMaxForNextSolves(
+    const RoutingDimension& dimension, int64_t index) const {
+  const IntVar* const cumul_var = dimension.CumulVar(index);
+  return next_solves_updates_->Contains(cumul_var) &&
+                 next_solves_updates_->Activated(cumul_var)
+             ? next_solves_updates_->Max(cumul_var)
+             : kint64max;
+}
+
+const Assignment* RoutingModel::ReoptimizeFromAssignmentWithParameters(
+    const Assignment* assignment,
+    const RoutingSearchParameters& search_parameters,
+    std::vector<const Assignment*>* solutions) {
+  const int64_t start_time_ms = solver_->wall_time();
+  QuietCloseModelWithParameters(search_parameters);
+  if (assignment != nullptr &&
+      status_ != RoutingSearchStatus::ROUTING_INVALID) {
+    std::vector<std::vector<int64_t>> routes;
+    AssignmentToRoutes(*assignment, &routes);
+    for (std::vector<int64_t>& route : routes) {
+      route.erase(std::remove_if(route.begin(), route.end(),
+                                 [this](int64_t index) {
+                                   return IsIndexDeactivatedForNextSolves(
+                                       index);
+                                 }),
+                  route.end());
+    }
+    Assignment* const start_assignment = solver_->MakeAssignment();
+    if (RoutesToAssignment(routes, /*ignore_inactive_indices=*/true,
+                           /*close_routes=*/true, start_assignment)) {
+      const Assignment* const solution = SolveFromAssignmentWithParameters(
+          start_assignment, search_parameters, solutions);
+      if (solution != nullptr ||
+          status_ == RoutingSearchStatus::ROUTING_FAIL_TIMEOUT) {
+        return solution;
+      }
+      // The updates made the previous routes infeasible.
+      VLOG(1) << "Re-optimization falls back to a solve from scratch.";
+    }
+  }
+  const absl::Duration time_limit = GetTimeLimit(search_parameters);
+  if (time_limit == absl::InfiniteDuration()) {
+    return SolveWithParameters(search_parameters, solutions);
+  }
+  // The solve from scratch only gets the time left by the re-optimization.
+  RoutingSearchParameters fallback_parameters = search_parameters;
+  util_time::EncodeGoogleApiProto(
+      std::max(absl::ZeroDuration(),
+               time_limit -
+                   absl::Milliseconds(solver_->wall_time() - start_time_ms)),
+      fallback_parameters.mutable_time_limit())
+      .IgnoreError();
+  return SolveWithParameters(fallback_parameters, solutions);
+}
+
 int64_t RoutingModel::GetNumberOfDecisionsInFirstSolution(
     const RoutingSearchParameters& parameters) const {
   IntVarFilteredDecisionBuilder* const decision_builder =
@@ -4070,23 +4533,37 @@ int64_t RoutingModel::GetArcCostForClassInternal(
   DCHECK(closed_);
   DCHECK_GE(cost_class_index, 0);
   DCHECK_LT(cost_class_index, cost_classes_.size());
+  if (const std::optional<int64_t> cost =
+          GetArcCostFromTable(from_index, to_index, cost_class_index);
+      cost.has_value()) {
+    return *cost;
+  }
   CostCacheElement* const cache = &cost_cache_[from_index];
   // See the comment in CostCacheElement in the .h for the int64_t->int cast.
   if (cache->index == static_cast<int>(to_index) &&
       cache->cost_class_index == cost_class_index) {
     return cache->cost;
   }
+  const int64_t cost =
+      ComputeArcCostForClass(from_index, to_index, cost_class_index);
+  *cache = {static_cast<int>(to_index), cost_class_index, cost};
+  return cost;
+}
+
+int64_t RoutingModel::ComputeArcCostForClass(
+    int64_t from_index, int64_t to_index,
+    CostClassIndex cost_class_index) const {
   int64_t cost = 0;
   const CostClass& cost_class = cost_classes_[cost_class_index];
-  const auto& evaluator = transit_evaluators_[cost_class.evaluator_index];
+  const int evaluator_index = cost_class.evaluator_index;
   if (!IsStart(from_index)) {
-    cost = CapAdd(evaluator(from_index, to_index),
+    cost = CapAdd(EvaluateTransit(evaluator_index, from_index, to_index),
                   GetDimensionTransitCostSum(from_index, to_index, cost_class));
   } else if (!IsEnd(to_index)) {
     // Apply route fixed cost on first non-first/last node, in other words on
     // the arc from the first node to its next node if it's not the last node.
     cost = CapAdd(
-        evaluator(from_index, to_index),
+        EvaluateTransit(evaluator_index, from_index, to_index),
         CapAdd(GetDimensionTransitCostSum(from_index, to_index, cost_class),
                fixed_cost_of_vehicle_[VehicleIndex(from_index)]));
   } else {
@@ -4094,16 +4571,91 @@ int64_t RoutingModel::GetArcCostForClassInternal(
     // as an empty route.
     if (vehicle_used_when_empty_[VehicleIndex(from_index)]) {
       cost =
-          CapAdd(evaluator(from_index, to_index),
+          CapAdd(EvaluateTransit(evaluator_index, from_index, to_index),
                  GetDimensionTransitCostSum(from_index, to_index, cost_class));
     } else {
       cost = 0;
     }
   }
-  *cache = {static_cast<int>(to_index), cost_class_index, cost};
   return cost;
 }
 
+void RoutingModel::ComputeArcCostTable() {
+  arc_cost_table_.clear();
+  arc_cost_table_successors_.clear();
+  arc_cost_table_row_size_ = 0;
+  const int64_t size = Size();
+  const int64_t num_successors = size + vehicles_;
+  const int64_t num_rows = cost_classes_.size() * size;
+  if (max_arc_cost_table_memory_bytes_ <= 0 || num_rows == 0) return;
+  constexpr int64_t kDenseBytesPerArc = sizeof(int64_t);
+  constexpr int64_t kSparseBytesPerArc = sizeof(int64_t) + sizeof(int);
+  const bool dense = max_arc_cost_table_memory_bytes_ /
+                         (num_rows * kDenseBytesPerArc) >=
+                     num_successors;
+  const int64_t row_size =
+      dense ? num_successors
+            : std::min(num_successors - 1,
+                       max_arc_cost_table_memory_bytes_ /
+                           (num_rows * kSparseBytesPerArc));
+  if (row_size == 0) return;
+  arc_cost_table_.resize(num_rows * row_size);
+  if (!dense) arc_cost_table_successors_.resize(num_rows * row_size);
+  RunOnBlocks(size, num_threads_for_node_neighbors_, [&](int begin, int end) {
+    std::vector<std::pair<int64_t, int>> costs;
+    for (int from = begin; from < end; ++from) {
+      if (IsStart(from)) continue;
+      for (const CostClassIndex cost_class : cost_classes_.index_range()) {
+        const int64_t row_start =
+            (cost_class.value() * size + from) * row_size;
+        if (dense) {
+          for (int to = 0; to < num_successors; ++to) {
+            arc_cost_table_[row_start + to] =
+                ComputeArcCostForClass(from, to, cost_class);
+          }
+          continue;
+        }
+        costs.clear();
+        for (int to = 0; to < num_successors; ++to) {
+          if (to == from) continue;
+          costs.push_back({ComputeArcCostForClass(from, to, cost_class), to});
+        }
+        std::nth_element(costs.begin(), costs.begin() + row_size - 1,
+                         costs.end());
+        std::sort(costs.begin(), costs.begin() + row_size,
+                  [](const std::pair<int64_t, int>& a,
+                     const std::pair<int64_t, int>& b) {
+                    return a.second < b.second;
+                  });
+        for (int i = 0; i < row_size; ++i) {
+          arc_cost_table_[row_start + i] = costs[i].first;
+          arc_cost_table_successors_[row_start + i] = costs[i].second;
+        }
+      }
+    }
+  });
+  arc_cost_table_row_size_ = row_size;
+}
+
+std::optional<int64_t> RoutingModel::GetArcCostFromTable(
+    int64_t from_index, int64_t to_index,
+    CostClassIndex cost_class_index) const {
+  if (arc_cost_table_row_size_ == 0 || IsStart(from_index)) {
+    return std::nullopt;
+  }
+  const int64_t row_start =
+      (cost_class_index.value() * Size() + from_index) *
+      arc_cost_table_row_size_;
+  if (arc_cost_table_successors_.empty()) {
+    return arc_cost_table_[row_start + to_index];
+  }
+  const auto row_begin = arc_cost_table_successors_.begin() + row_start;
+  const auto row_end = row_begin + arc_cost_table_row_size_;
+  const auto it = std::lower_bound(row_begin, row_end, to_index);
+  if (it == row_end || *it != to_index) return std::nullopt;
+  return arc_cost_table_[it - arc_cost_table_successors_.begin()];
+}
+
 std::function<int64_t(int64_t, int64_t, int64_t)>
 RoutingModel::GetLocalSearchArcCostCallback(
     const RoutingSearchParameters& parameters) const {
@@ -4155,6 +4707,21 @@ int64_t RoutingModel::GetArcCostForVehicle(int64_t from_index, int64_t to_index,
   }
 }
 
+int64_t RoutingModel::GetArcCostForVehicleWithoutCache(
+    int64_t from_index, int64_t to_index, int64_t vehicle) const {
+  if (from_index != to_index && vehicle >= 0) {
+    const CostClassIndex cost_class_index = GetCostClassIndexOfVehicle(vehicle);
+    if (const std::optional<int64_t> cost =
+            GetArcCostFromTable(from_index, to_index, cost_class_index);
+        cost.has_value()) {
+      return *cost;
+    }
+    return ComputeArcCostForClass(from_index, to_index, cost_class_index);
+  } else {
+    return 0;
+  }
+}
+
 int64_t RoutingModel::GetArcCostForClass(
     int64_t from_index, int64_t to_index,
     int64_t /*CostClassIndex*/ cost_class_index) const {
@@ -5845,6 +6412,10 @@ void RoutingModel::CreateFirstSolutionDecisionBuilders(
           .cheapest_insertion_first_solution_use_neighbors_ratio_for_initialization();  // NOLINT
   gci_parameters.add_unperformed_entries =
       search_parameters.cheapest_insertion_add_unperformed_entries();
+  gci_parameters.num_threads =
+      search_parameters.cheapest_insertion_num_threads();
+  // The arc cost cache is not thread-safe.
+  const bool use_arc_cost_cache = gci_parameters.num_threads <= 1;
   for (bool is_sequential : {false, true}) {
     FirstSolutionStrategy::Value first_solution_strategy =
         is_sequential ? FirstSolutionStrategy::SEQUENTIAL_CHEAPEST_INSERTION
@@ -5854,8 +6425,10 @@ void RoutingModel::CreateFirstSolutionDecisionBuilders(
     first_solution_filtered_decision_builders_[first_solution_strategy] =
         CreateIntVarFilteredDecisionBuilder<
             GlobalCheapestInsertionFilteredHeuristic>(
-            [this](int64_t i, int64_t j, int64_t vehicle) {
-              return GetArcCostForVehicle(i, j, vehicle);
+            [this, use_arc_cost_cache](int64_t i, int64_t j, int64_t vehicle) {
+              return use_arc_cost_cache
+                         ? GetArcCostForVehicle(i, j, vehicle)
+                         : GetArcCostForVehicleWithoutCache(i, j, vehicle);
             },
             [this](int64_t i) { return UnperformedPenaltyOrValue(0, i); },
             GetOrCreateLocalSearchFilterManager(
@@ -5865,8 +6438,10 @@ void RoutingModel::CreateFirstSolutionDecisionBuilders(
     IntVarFilteredDecisionBuilder* const strong_gci =
         CreateIntVarFilteredDecisionBuilder<
             GlobalCheapestInsertionFilteredHeuristic>(
-            [this](int64_t i, int64_t j, int64_t vehicle) {
-              return GetArcCostForVehicle(i, j, vehicle);
+            [this, use_arc_cost_cache](int64_t i, int64_t j, int64_t vehicle) {
+              return use_arc_cost_cache
+                         ? GetArcCostForVehicle(i, j, vehicle)
+                         : GetArcCostForVehicleWithoutCache(i, j, vehicle);
             },
             [this](int64_t i) { return UnperformedPenaltyOrValue(0, i); },
             GetOrCreateLocalSearchFilterManager(
@@ -6185,7 +6760,8 @@ void RoutingModel::SetupDecisionBuilders(
   }
   CHECK(preassignment_ != nullptr);
   DecisionBuilder* restore_preassignment =
-      solver_->MakeRestoreAssignment(preassignment_);
+      solver_->Compose(solver_->MakeRestoreAssignment(preassignment_),
+                       solver_->MakeRestoreAssignment(next_solves_updates_));
   solve_db_ = solver_->Compose(restore_preassignment, solve_db_);
 
   improve_db_ =
@@ -7089,7 +7665,8 @@ void RoutingDimension::CloseModel(bool use_light_propagation) {
 int64_t RoutingDimension::GetTransitValue(int64_t from_index, int64_t to_index,
                                           int64_t vehicle) const {
   DCHECK(transit_evaluator(vehicle) != nullptr);
-  return transit_evaluator(vehicle)(from_index, to_index);
+  return model_->EvaluateTransit(class_evaluators_[vehicle_to_class_[vehicle]],
+                                 from_index, to_index);
 }
 
 bool RoutingDimension::AllTransitEvaluatorSignsAreUnknown() const {
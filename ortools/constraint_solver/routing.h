@@ -186,10 +186,12 @@
 #include "ortools/constraint_solver/routing_enums.pb.h"
 #include "ortools/constraint_solver/routing_index_manager.h"
 #include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/routing_transit_matrix.h"
 #include "ortools/constraint_solver/routing_types.h"
 #include "ortools/constraint_solver/routing_utils.h"
 #include "ortools/graph/graph.h"
 #include "ortools/sat/theta_tree.h"
+#include "ortools/util/bitset.h"
 #include "ortools/util/piecewise_linear_function.h"
 #include "ortools/util/range_query_function.h"
 #include "ortools/util/saturated_arithmetic.h"
@@ -206,6 +208,7 @@ class IntVarFilteredDecisionBuilder;
 class RoutingDimension;
 #ifndef SWIG
 using util::ReverseArcListGraph;
+class SharedRoutingSolutionPool;
 class SweepArranger;
 #endif
 
@@ -638,6 +641,12 @@ class OR_DLL RoutingModel {
 
   int RegisterTransitMatrix(
       std::vector<std::vector<int64_t> /*needed_for_swig*/> values);
+  /// Registers a transit matrix indexed by nodes. Unlike callbacks, the matrix
+  /// is read directly by the arc cost, dimension and filter hot paths, and is
+  /// stored with the smallest integer type representing all its values. See
+  /// RoutingTransitMatrix to memory-map a large matrix from a file.
+  int RegisterCompactTransitMatrix(
+      std::unique_ptr<RoutingTransitMatrix> matrix);
   int RegisterTransitCallback(
       TransitCallback2 callback,
       TransitEvaluatorSign sign = kTransitEvaluatorSignUnknown);
@@ -649,6 +658,24 @@ class OR_DLL RoutingModel {
     CHECK_LT(callback_index, transit_evaluators_.size());
     return transit_evaluators_[callback_index];
   }
+  /// Returns the matrix of a callback registered with
+  /// RegisterCompactTransitMatrix() or RegisterTransitMatrix(), nullptr
+  /// otherwise.
+  const RoutingTransitMatrix* TransitMatrixOrNull(int callback_index) const {
+    CHECK_LT(callback_index, transit_matrices_.size());
+    return transit_matrices_[callback_index].get();
+  }
+  /// Same as TransitCallback(callback_index)(from_index, to_index), but
+  /// bypasses the std::function when the callback is a transit matrix.
+  int64_t EvaluateTransit(int callback_index, int64_t from_index,
+                          int64_t to_index) const {
+    DCHECK_LT(callback_index, transit_matrices_.size());
+    const RoutingTransitMatrix* const matrix =
+        transit_matrices_[callback_index].get();
+    return matrix != nullptr
+               ? matrix->Evaluate(from_index, to_index)
+               : transit_evaluators_[callback_index](from_index, to_index);
+  }
   const TransitCallback1& UnaryTransitCallbackOrNull(int callback_index) const {
     CHECK_LT(callback_index, unary_transit_evaluators_.size());
     return unary_transit_evaluators_[callback_index];
@@ -1419,6 +1446,37 @@ class OR_DLL RoutingModel {
   /// approach.
   const Assignment* SolveWithIteratedLocalSearch(
       const RoutingSearchParameters& search_parameters);
+#ifndef SWIG
+  /// Runs SolveWithIteratedLocalSearch() on the given models in parallel, one
+  /// thread per model, the workers periodically sharing their best solution
+  /// (see IteratedLocalSearchParameters). A RoutingModel cannot be used by
+  /// several threads, so the models must be identical copies; large transit
+  /// matrices can be shared between them by loading them as memory-mapped
+  /// RoutingTransitMatrix. Worker i uses the random seed i.
+  /// Returns the best solution as an assignment of models[0], or nullptr if no
+  /// solution was found.
+  static const Assignment* SolveWithParallelIteratedLocalSearch(
+      absl::Span<RoutingModel* const> models,
+      const RoutingSearchParameters& search_parameters);
+  /// Decomposition approach for very large models, in the spirit of POPMUSIC.
+  /// After a first solution of models[0], each round partitions the routes of
+  /// the current solution into groups of nearby routes (using the coordinates
+  /// given to SetNodeCoordinates() if any, arc costs otherwise), and each
+  /// unperformed node into the group of the closest route. The groups are
+  /// then optimized in parallel with a time limit, each one on one of the
+  /// models with the rest of the solution locked, and the new routes are
+  /// merged and kept if the merged solution is better; the rounds stop at the
+  /// first one which does not improve the solution. The locks of the
+  /// models, as set by ApplyLocksToAllVehicles() for instance, are respected
+  /// by all the subproblems and left unchanged.
+  /// See RoutingSearchParameters.route_decomposition_parameters. As in
+  /// SolveWithParallelIteratedLocalSearch(), the models must be identical
+  /// copies. Returns the best solution as an assignment of models[0], or
+  /// nullptr if no solution was found.
+  static const Assignment* SolveWithRouteDecomposition(
+      absl::Span<RoutingModel* const> models,
+      const RoutingSearchParameters& search_parameters);
+#endif  // SWIG
   /// Given a "source_model" and its "source_assignment", resets
   /// "target_assignment" with the IntVar variables (nexts_, and vehicle_vars_
   /// if costs aren't homogeneous across vehicles) of "this" model, with the
@@ -1460,6 +1518,53 @@ class OR_DLL RoutingModel {
   /// PreAssignment().
   bool ApplyLocksToAllVehicles(const std::vector<std::vector<int64_t>>& locks,
                                bool close_routes);
+  /// Incremental updates, to re-optimize a closed model after small changes
+  /// instead of building a new model: the caches, neighbors and filters of the
+  /// model are kept from one solve to the next. The updates apply to all the
+  /// next searches until they are reverted, and can only restrict the model.
+  /// The cumul ranges are enforced by the solver and by the dimension filters,
+  /// which refresh their cumul bounds at their next synchronization; like the
+  /// locks, the deactivations are enforced by the solver only.
+  ///
+  /// Forces the optional 'index', which must belong to a disjunction, to be
+  /// unperformed if 'deactivated' is true, which removes it from the problem
+  /// (its penalty is still counted), and reverts this otherwise, which adds it
+  /// back. Vehicle starts and ends cannot be deactivated.
+  void SetIndexDeactivatedForNextSolves(int64_t index, bool deactivated);
+  bool IsIndexDeactivatedForNextSolves(int64_t index) const;
+  /// Restricts the cumul of 'index' in 'dimension' to [min, max], which must
+  /// intersect the range of the cumul variable; for instance to update a time
+  /// window, or the time at which a vehicle is available at its start.
+  void SetCumulRangeForNextSolves(const RoutingDimension& dimension,
+                                  int64_t index, int64_t min, int64_t max);
+  void ClearCumulRangeForNextSolves(const RoutingDimension& dimension,
+                                    int64_t index);
+  /// Returns the bounds to which the updates restrict the cumul of 'index' in
+  /// 'dimension', kint64min and kint64max if its range is not set.
+  int64_t GetCumulMinForNextSolves(const RoutingDimension& dimension,
+                                   int64_t index) const;
+  int64_t GetCumulMaxForNextSolves(const RoutingDimension& dimension,
+                                   int64_t index) const;
+  /// Reverts all the incremental updates.
+  void ClearUpdatesForNextSolves() {
+    next_solves_updates_->Clear();
+    ++next_solves_updates_stamp_;
+  }
+#ifndef SWIG
+  /// Returns a stamp which changes each time the incremental updates change;
+  /// the filters compare it to the stamp of their cached cumul bounds.
+  int64_t next_solves_updates_stamp() const {
+    return next_solves_updates_stamp_;
+  }
+#endif  // SWIG
+  /// Solves the model after incremental updates, starting from 'assignment',
+  /// typically the solution of the previous solve, from which the deactivated
+  /// indices are removed. Falls back to a solve from scratch if the routes of
+  /// 'assignment' are not feasible anymore, or if 'assignment' is null.
+  const Assignment* ReoptimizeFromAssignmentWithParameters(
+      const Assignment* assignment,
+      const RoutingSearchParameters& search_parameters,
+      std::vector<const Assignment*>* solutions = nullptr);
   /// Returns an assignment used to fix some of the variables of the problem.
   /// In practice, this assignment locks partial routes of the problem. This
   /// can be used in the context of locking the parts of the routes which have
@@ -1606,6 +1711,14 @@ class OR_DLL RoutingModel {
   void SetSweepArranger(SweepArranger* sweep_arranger);
   /// Returns the sweep arranger to be used by routing heuristics.
   SweepArranger* sweep_arranger() const;
+  /// Sets the coordinates of the nodes, indexed by RoutingIndexManager node.
+  /// When set, the neighbors of a node (see
+  /// GetOrCreateNodeNeighborsByCostClass()) are selected among its nearest
+  /// nodes in the plane instead of among all nodes, which avoids evaluating
+  /// all arc costs on large models. The selection is exact when arc costs
+  /// increase with the Euclidean distance, and a heuristic otherwise.
+  void SetNodeCoordinates(
+      absl::Span<const std::pair<int64_t, int64_t>> node_coordinates);
 #endif
   struct NodeNeighborsParameters {
     int num_neighbors;
@@ -1690,7 +1803,7 @@ class OR_DLL RoutingModel {
         return false;
       }
       return node_index_to_outgoing_neighbor_indicator_by_cost_class_
-          [cost_class][from][to];
+          [cost_class][from * indicator_row_size_ + to];
     }
 
    private:
@@ -1705,8 +1818,11 @@ class OR_DLL RoutingModel {
         node_index_to_incoming_neighbors_by_cost_class_;
     std::vector<std::vector<std::vector<int>>>
         node_index_to_outgoing_neighbors_by_cost_class_;
-    std::vector<std::vector<std::vector<bool>>>
+    // The bit of from -> to is at from * indicator_row_size_ + to. Rows are
+    // padded to a multiple of 64 bits so that they can be filled concurrently.
+    std::vector<Bitset64<int64_t>>
         node_index_to_outgoing_neighbor_indicator_by_cost_class_;
+    int64_t indicator_row_size_ = 0;
 
     std::vector<int> all_outgoing_nodes_;
     std::vector<int> all_incoming_nodes_;
@@ -1808,6 +1924,12 @@ class OR_DLL RoutingModel {
   /// Input are variable indices of node. This returns 0 if vehicle < 0.
   int64_t GetArcCostForVehicle(int64_t from_index, int64_t to_index,
                                int64_t vehicle) const;
+  /// Same as GetArcCostForVehicle() but bypasses the arc cost cache, which is
+  /// not thread-safe. This can be called concurrently as long as the transit
+  /// callbacks used by the costs are thread-safe.
+  int64_t GetArcCostForVehicleWithoutCache(int64_t from_index,
+                                           int64_t to_index,
+                                           int64_t vehicle) const;
   /// Whether costs are homogeneous across all vehicles.
   bool CostsAreHomogeneousAcrossVehicles() const {
     return costs_are_homogeneous_across_vehicles_;
@@ -2253,6 +2375,15 @@ class OR_DLL RoutingModel {
   void TopologicallySortVisitTypes();
   int64_t GetArcCostForClassInternal(int64_t from_index, int64_t to_index,
                                      CostClassIndex cost_class_index) const;
+  // Computes the cost of the arc, without using the cost cache.
+  int64_t ComputeArcCostForClass(int64_t from_index, int64_t to_index,
+                                 CostClassIndex cost_class_index) const;
+  // Fills the arc cost table, see arc_cost_table_ below.
+  void ComputeArcCostTable();
+  // Returns the cost of the arc if it is in the arc cost table.
+  std::optional<int64_t> GetArcCostFromTable(
+      int64_t from_index, int64_t to_index,
+      CostClassIndex cost_class_index) const;
   int64_t GetArcCostWithGuidedLocalSearchPenalties(int64_t from_index,
                                                    int64_t to_index,
                                                    int64_t vehicle) const {
@@ -2312,6 +2443,12 @@ class OR_DLL RoutingModel {
   bool ReplaceUnusedVehicle(int unused_vehicle, int active_vehicle,
                             Assignment* compact_assignment) const;
 
+  // Runs the iterated local search of the given worker. If pool is not
+  // nullptr, the best solution is periodically shared with the other workers.
+  const Assignment* SolveWithIteratedLocalSearchInternal(
+      const RoutingSearchParameters& parameters, int worker,
+      SharedRoutingSolutionPool* pool);
+
   void QuietCloseModel();
   void QuietCloseModelWithParameters(
       const RoutingSearchParameters& parameters) {
@@ -2530,6 +2667,17 @@ class OR_DLL RoutingModel {
   bool costs_are_homogeneous_across_vehicles_;
   bool cache_callbacks_;
   mutable std::vector<CostCacheElement> cost_cache_;  /// Index by source index.
+  /// Arc costs computed by ComputeArcCostTable(), by cost class and source
+  /// index, with arc_cost_table_row_size_ costs per source. The table is
+  /// empty if RoutingModelParameters.max_arc_cost_table_memory_bytes is 0.
+  /// If the rows cannot hold all the successors, each row holds the cheapest
+  /// ones, whose indices are stored in arc_cost_table_successors_ in
+  /// increasing order. The rows of the vehicle starts are not filled since
+  /// their costs include the fixed cost of the vehicle.
+  int64_t max_arc_cost_table_memory_bytes_ = 0;
+  int64_t arc_cost_table_row_size_ = 0;
+  std::vector<int64_t> arc_cost_table_;
+  std::vector<int> arc_cost_table_successors_;
   std::vector<VehicleClassIndex> vehicle_class_index_of_vehicle_;
   int num_vehicle_classes_;
 
@@ -2661,6 +2809,9 @@ class OR_DLL RoutingModel {
   DecisionBuilder* restore_tmp_assignment_ = nullptr;
   Assignment* assignment_ = nullptr;
   Assignment* preassignment_ = nullptr;
+  // The incremental updates, restored right after preassignment_.
+  Assignment* next_solves_updates_ = nullptr;
+  int64_t next_solves_updates_stamp_ = 0;
   Assignment* tmp_assignment_ = nullptr;
   LocalSearchOperator* primary_ls_operator_ = nullptr;
   LocalSearchOperator* secondary_ls_operator_ = nullptr;
@@ -2676,6 +2827,9 @@ class OR_DLL RoutingModel {
   std::unique_ptr<FinalizerVariables> finalizer_variables_;
 #ifndef SWIG
   std::unique_ptr<SweepArranger> sweep_arranger_;
+  // Coordinates of each index, empty if SetNodeCoordinates() was not called.
+  std::vector<std::pair<int64_t, int64_t>> index_coordinates_;
+  int num_threads_for_node_neighbors_ = 1;
 #endif
 
   RegularLimit* limit_ = nullptr;
@@ -2704,6 +2858,9 @@ class OR_DLL RoutingModel {
   std::vector<TransitCallback1> unary_transit_evaluators_;
   std::vector<TransitCallback2> transit_evaluators_;
   std::vector<TransitEvaluatorSign> transit_evaluator_sign_;
+  // Same size as transit_evaluators_: the matrix of the callbacks registered
+  // as transit matrices, nullptr for the other callbacks.
+  std::vector<std::unique_ptr<RoutingTransitMatrix>> transit_matrices_;
 
   std::vector<VariableIndexEvaluator2> state_dependent_transit_evaluators_;
   std::vector<std::unique_ptr<StateDependentTransitCallbackCache>>
@@ -3167,8 +3324,8 @@ class RoutingDimension {
   /// vehicle (the class of a vehicle can be obtained with vehicle_to_class()).
   int64_t GetTransitValueFromClass(int64_t from_index, int64_t to_index,
                                    int64_t vehicle_class) const {
-    return model_->TransitCallback(class_evaluators_[vehicle_class])(from_index,
-                                                                     to_index);
+    return model_->EvaluateTransit(class_evaluators_[vehicle_class],
+                                   from_index, to_index);
   }
   /// Get the cumul, transit and slack variables for the given node (given as
   /// int64_t var index).
@@ -3254,6 +3411,13 @@ class RoutingDimension {
         class_evaluators_[vehicle_to_class_[vehicle]]);
   }
 
+  /// Returns the transit matrix of the given vehicle if its transit evaluator
+  /// was registered as a matrix, nullptr otherwise.
+  const RoutingTransitMatrix* GetTransitMatrixOrNull(int vehicle) const {
+    return model_->TransitMatrixOrNull(
+        class_evaluators_[vehicle_to_class_[vehicle]]);
+  }
+
   /// Returns the callback evaluating the transit value between two node indices
   /// for a given vehicle class.
   const RoutingModel::TransitCallback2& class_transit_evaluator(
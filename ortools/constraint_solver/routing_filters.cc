@@ -47,6 +47,7 @@
 #include "ortools/constraint_solver/routing.h"
 #include "ortools/constraint_solver/routing_lp_scheduling.h"
 #include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/routing_transit_matrix.h"
 #include "ortools/constraint_solver/routing_types.h"
 #include "ortools/util/bitset.h"
 #include "ortools/util/piecewise_linear_function.h"
@@ -1223,6 +1224,10 @@ class PathCumulFilter : public BasePathFilter {
   // Data extractors used in constructor.
   std::vector<Interval> ExtractInitialCumulIntervals();
   std::vector<Interval> ExtractInitialSlackIntervals();
+  // Restricts initial_cumul_ by the model's updates for the next solves into
+  // cumul_intervals_, if the updates changed since the last call. Returns true
+  // iff they changed.
+  bool RefreshCumulIntervals();
   std::vector<std::vector<RoutingDimension::NodePrecedence>>
   ExtractNodeIndexToPrecedences() const;
   std::vector<SoftBound> ExtractCumulSoftUpperBounds() const;
@@ -1230,6 +1235,7 @@ class PathCumulFilter : public BasePathFilter {
   std::vector<const PiecewiseLinearFunction*> ExtractCumulPiecewiseLinearCosts()
       const;
   std::vector<const RoutingModel::TransitCallback2*> ExtractEvaluators() const;
+  std::vector<const RoutingTransitMatrix*> ExtractTransitMatrices() const;
   using VehicleBreak = DimensionValues::VehicleBreak;
   std::vector<std::vector<VehicleBreak>> ExtractInitialVehicleBreaks() const;
 
@@ -1246,6 +1252,7 @@ class PathCumulFilter : public BasePathFilter {
   bool FinalizeAcceptPath(int64_t objective_min,
                           int64_t objective_max) override;
 
+  void OnSynchronize(const Assignment* delta) override;
   void OnBeforeSynchronizePaths(bool synchronizing_all_paths) override;
   void OnSynchronizePathFromStart(int64_t start) override;
   void OnAfterSynchronizePaths() override;
@@ -1326,10 +1333,16 @@ class PathCumulFilter : public BasePathFilter {
   const RoutingModel& routing_model_;
   const RoutingDimension& dimension_;
   const std::vector<Interval> initial_cumul_;
+  // The cumul intervals used by the filter: initial_cumul_ restricted by the
+  // model's updates for the next solves, as of next_solves_updates_stamp_.
+  std::vector<Interval> cumul_intervals_;
+  int64_t next_solves_updates_stamp_;
   const std::vector<Interval> initial_slack_;
   const std::vector<std::vector<VehicleBreak>> initial_vehicle_breaks_;
   // Maps vehicle/path to their values, values are always present.
   const std::vector<const RoutingModel::TransitCallback2*> evaluators_;
+  // The transit matrix of each path, nullptr if its evaluator is not a matrix.
+  const std::vector<const RoutingTransitMatrix*> transit_matrices_;
   const std::vector<int64_t> path_capacities_;
   const std::vector<int64_t> path_span_upper_bounds_;
   const std::vector<int64_t> path_total_slack_cost_coefficients_;
@@ -1452,6 +1465,19 @@ PathCumulFilter::ExtractInitialCumulIntervals() {
   return intervals;
 }
 
+bool PathCumulFilter::RefreshCumulIntervals() {
+  const int64_t stamp = routing_model_.next_solves_updates_stamp();
+  if (stamp == next_solves_updates_stamp_) return false;
+  next_solves_updates_stamp_ = stamp;
+  for (int i = 0; i < initial_cumul_.size(); ++i) {
+    const int64_t min = routing_model_.GetCumulMinForNextSolves(dimension_, i);
+    const int64_t max = routing_model_.GetCumulMaxForNextSolves(dimension_, i);
+    cumul_intervals_[i] = {std::max(initial_cumul_[i].min, min),
+                           std::min(initial_cumul_[i].max, max)};
+  }
+  return true;
+}
+
 std::vector<PathCumulFilter::Interval>
 PathCumulFilter::ExtractInitialSlackIntervals() {
   std::vector<Interval> intervals;
@@ -1522,6 +1548,16 @@ PathCumulFilter::ExtractEvaluators() const {
   return evaluators;
 }
 
+std::vector<const RoutingTransitMatrix*>
+PathCumulFilter::ExtractTransitMatrices() const {
+  const int num_paths = NumPaths();
+  std::vector<const RoutingTransitMatrix*> matrices(num_paths);
+  for (int i = 0; i < num_paths; ++i) {
+    matrices[i] = dimension_.GetTransitMatrixOrNull(i);
+  }
+  return matrices;
+}
+
 std::vector<std::vector<RoutingDimension::NodePrecedence>>
 PathCumulFilter::ExtractNodeIndexToPrecedences() const {
   std::vector<std::vector<RoutingDimension::NodePrecedence>>
@@ -1568,9 +1604,12 @@ PathCumulFilter::PathCumulFilter(const RoutingModel& routing_model,
       routing_model_(routing_model),
       dimension_(dimension),
       initial_cumul_(ExtractInitialCumulIntervals()),
+      cumul_intervals_(initial_cumul_),
+      next_solves_updates_stamp_(-1),
       initial_slack_(ExtractInitialSlackIntervals()),
       initial_vehicle_breaks_(ExtractInitialVehicleBreaks()),
       evaluators_(ExtractEvaluators()),
+      transit_matrices_(ExtractTransitMatrices()),
 
       path_capacities_(dimension.vehicle_capacities()),
       path_span_upper_bounds_(dimension.vehicle_span_upper_bounds()),
@@ -1721,7 +1760,7 @@ bool PathCumulFilter::FillDimensionValues(int path) {
   const int64_t capacity = path_capacities_[path];
   for (int r = 0; r < num_nodes; ++r) {
     const int node = nodes[r];
-    Interval cumul = initial_cumul_[node];
+    Interval cumul = cumul_intervals_[node];
     if (!cumul.DecreaseMax(capacity)) return false;
     cumuls[r] = cumul;
   }
@@ -1732,11 +1771,13 @@ bool PathCumulFilter::FillDimensionValues(int path) {
   absl::Span<Interval> transits = dimension_values_.MutableTransits(path);
   absl::Span<int64_t> travel_sums = dimension_values_.MutableTravelSums(path);
   const auto& evaluator = *evaluators_[path];
+  const RoutingTransitMatrix* const matrix = transit_matrices_[path];
   int64_t total_travel = 0;
   travel_sums[0] = 0;
   for (int r = 1; r < num_nodes; ++r) {
     const int node = nodes[r - 1];
-    const int64_t travel = evaluator(node, nodes[r]);
+    const int64_t travel = matrix != nullptr ? matrix->Evaluate(node, nodes[r])
+                                             : evaluator(node, nodes[r]);
     travels[r - 1] = travel;
     CapAddTo(travel, &total_travel);
     travel_sums[r] = total_travel;
@@ -2067,6 +2108,13 @@ bool PathCumulFilter::FinalizeAcceptPath(int64_t /*objective_min*/,
   return accepted_objective_value_ <= objective_max;
 }
 
+void PathCumulFilter::OnSynchronize(const Assignment* delta) {
+  // The data of the synchronized paths was computed with the previous cumul
+  // intervals, all paths must be synchronized again.
+  if (RefreshCumulIntervals()) delta = nullptr;
+  BasePathFilter::OnSynchronize(delta);
+}
+
 void PathCumulFilter::OnBeforeSynchronizePaths(bool synchronizing_all_paths) {
   if (synchronizing_all_paths) {
     // All paths are being synchronized, so we can reset all the data and let
@@ -2192,6 +2240,17 @@ bool DimensionHasPathCumulConstraint(const RoutingDimension& dimension) {
   return false;
 }
 
+// Returns the ranges of the cumul variables of 'dimension'.
+std::vector<DimensionChecker::Interval> ExtractCumulIntervals(
+    const RoutingDimension& dimension) {
+  std::vector<DimensionChecker::Interval> intervals;
+  intervals.reserve(dimension.cumuls().size());
+  for (const IntVar* cumul : dimension.cumuls()) {
+    intervals.push_back({cumul->Min(), cumul->Max()});
+  }
+  return intervals;
+}
+
 }  // namespace
 
 void AppendLightWeightDimensionFilters(
@@ -2218,7 +2277,6 @@ void AppendLightWeightDimensionFilters(
     // except we expand evaluator_index to an array of values for all nodes.
     const int num_vehicle_classes =
         1 + *std::max_element(path_class.begin(), path_class.end());
-    const int num_cumuls = dimension->cumuls().size();
     const int num_slacks = dimension->slacks().size();
     std::vector<std::function<Interval(int64_t, int64_t)>> transits(
         num_vehicle_classes, nullptr);
@@ -2250,19 +2308,14 @@ void AppendLightWeightDimensionFilters(
         };
       }
     }
-    // Fill node capacities.
-    std::vector<Interval> node_capacity(num_cumuls);
-    for (int node = 0; node < num_cumuls; ++node) {
-      const IntVar* cumul = dimension->CumulVar(node);
-      node_capacity[node] = {cumul->Min(), cumul->Max()};
-    }
-    // Make the dimension checker and pass ownership to the filter.
+    // Make the dimension checker and pass ownership to the filter, which
+    // updates the node capacities with the model's updates for next solves.
     auto checker = std::make_unique<DimensionChecker>(
         path_state, std::move(path_capacity), std::move(path_class),
-        std::move(transits), std::move(node_capacity));
+        std::move(transits), ExtractCumulIntervals(*dimension));
     const auto kAccept = LocalSearchFilterManager::FilterEventType::kAccept;
     LocalSearchFilter* filter = MakeDimensionFilter(
-        dimension->model()->solver(), std::move(checker), dimension->name());
+        dimension->model()->solver(), std::move(checker), *dimension);
     filters->push_back({filter, kAccept});
   }
 }
@@ -3920,7 +3973,6 @@ DimensionChecker::DimensionChecker(
           16, 4 * path_state_->NumNodes())),  // 16 and 4 are arbitrary.
       min_range_size_for_riq_(min_range_size_for_riq) {
   const int num_nodes = path_state_->NumNodes();
-  cached_demand_.resize(num_nodes);
   const int num_paths = path_state_->NumPaths();
   DCHECK_EQ(num_paths, path_capacity_.size());
   DCHECK_EQ(num_paths, path_class_.size());
@@ -3971,14 +4023,19 @@ bool DimensionChecker::Check() const {
         UpdateCumulUsingChainRIQ(first_index, last_index, path_capacity, cumul);
         if (IsEmpty(cumul)) return false;
         prev_node = chain.Last();
+      } else if (chain_is_cached) {
+        // The nodes of the chain have consecutive indices.
+        for (int index = first_index + 1; index <= last_index; ++index) {
+          cumul += demand_to_index_[index];
+          cumul &= capacity_of_index_[index];
+          cumul &= path_capacity;
+          if (IsEmpty(cumul)) return false;
+        }
+        prev_node = last_node;
       } else {
         for (const int node : chain.WithoutFirstNode()) {
-          const EInterval demand =
-              chain_is_cached
-                  ? cached_demand_[prev_node]
-                  : ToExtendedInterval(
-                        demand_per_path_class_[path_class](prev_node, node));
-          cumul += demand;
+          cumul += ToExtendedInterval(
+              demand_per_path_class_[path_class](prev_node, node));
           cumul &= node_capacity_[node];
           cumul &= path_capacity;
           if (IsEmpty(cumul)) return false;
@@ -3998,13 +4055,21 @@ void DimensionChecker::Commit() {
       change_size += chain.NumNodes();
     }
   }
-  if (current_layer_size + change_size <= maximum_riq_layer_size_) {
+  if (!needs_full_commit_ &&
+      current_layer_size + change_size <= maximum_riq_layer_size_) {
     IncrementalCommit();
   } else {
     FullCommit();
   }
 }
 
+void DimensionChecker::SetNodeCapacities(
+    const std::vector<Interval>& node_capacity) {
+  DCHECK_EQ(node_capacity.size(), node_capacity_.size());
+  node_capacity_ = ToExtendedIntervals(node_capacity);
+  needs_full_commit_ = true;
+}
+
 void DimensionChecker::IncrementalCommit() {
   for (const int path : path_state_->ChangedPaths()) {
     const int begin_index = riq_[0].size();
@@ -4014,8 +4079,11 @@ void DimensionChecker::IncrementalCommit() {
 }
 
 void DimensionChecker::FullCommit() {
+  needs_full_commit_ = false;
   // Clear all structures.
   for (auto& layer : riq_) layer.clear();
+  demand_to_index_.clear();
+  capacity_of_index_.clear();
   // Append all paths.
   const int num_paths = path_state_->NumPaths();
   for (int path = 0; path < num_paths; ++path) {
@@ -4039,7 +4107,6 @@ void DimensionChecker::AppendPathDemandsToSums(int path) {
                      : ToExtendedInterval(
                            demand_per_path_class_[path_class](prev, node));
     demand_sum += demand;
-    cached_demand_[prev] = demand;
     prev = node;
     // Store all data of current node.
     index_[node] = index++;
@@ -4048,8 +4115,9 @@ void DimensionChecker::AppendPathDemandsToSums(int path) {
                        .cumuls_to_lst = node_capacity_[node],
                        .tsum_at_fst = demand_sum,
                        .tsum_at_lst = demand_sum});
+    demand_to_index_.push_back(demand);
+    capacity_of_index_.push_back(node_capacity_[node]);
   }
-  cached_demand_[path_state_->End(path)] = {0, 0, 0, 0};
 }
 
 void DimensionChecker::UpdateRIQStructure(int begin_index, int end_index) {
@@ -4117,23 +4185,53 @@ namespace {
 
 class DimensionFilter : public LocalSearchFilter {
  public:
+  using Interval = DimensionChecker::Interval;
+
   std::string DebugString() const override { return name_; }
   DimensionFilter(std::unique_ptr<DimensionChecker> checker,
-                  absl::string_view dimension_name)
+                  absl::string_view dimension_name,
+                  const RoutingDimension* dimension = nullptr)
       : checker_(std::move(checker)),
-        name_(absl::StrCat("DimensionFilter(", dimension_name, ")")) {}
+        name_(absl::StrCat("DimensionFilter(", dimension_name, ")")),
+        dimension_(dimension),
+        initial_node_capacity_(dimension == nullptr
+                                   ? std::vector<Interval>()
+                                   : ExtractCumulIntervals(*dimension)),
+        next_solves_updates_stamp_(-1) {}
 
   bool Accept(const Assignment*, const Assignment*, int64_t, int64_t) override {
     return checker_->Check();
   }
 
   void Synchronize(const Assignment*, const Assignment*) override {
+    if (dimension_ != nullptr) RefreshNodeCapacities();
     checker_->Commit();
   }
 
  private:
+  // Restricts the node capacities of the checker by the model's updates for
+  // the next solves, if they changed since the last call.
+  void RefreshNodeCapacities() {
+    const RoutingModel& model = *dimension_->model();
+    const int64_t stamp = model.next_solves_updates_stamp();
+    if (stamp == next_solves_updates_stamp_) return;
+    next_solves_updates_stamp_ = stamp;
+    std::vector<Interval> node_capacity = initial_node_capacity_;
+    for (int node = 0; node < node_capacity.size(); ++node) {
+      Interval& capacity = node_capacity[node];
+      capacity.min = std::max(
+          capacity.min, model.GetCumulMinForNextSolves(*dimension_, node));
+      capacity.max = std::min(
+          capacity.max, model.GetCumulMaxForNextSolves(*dimension_, node));
+    }
+    checker_->SetNodeCapacities(node_capacity);
+  }
+
   std::unique_ptr<DimensionChecker> checker_;
   const std::string name_;
+  const RoutingDimension* const dimension_;
+  const std::vector<Interval> initial_node_capacity_;
+  int64_t next_solves_updates_stamp_;
 };
 
 }  // namespace
@@ -4146,6 +4244,14 @@ LocalSearchFilter* MakeDimensionFilter(
   return solver->RevAlloc(filter);
 }
 
+LocalSearchFilter* MakeDimensionFilter(
+    Solver* solver, std::unique_ptr<DimensionChecker> checker,
+    const RoutingDimension& dimension) {
+  DimensionFilter* filter =
+      new DimensionFilter(std::move(checker), dimension.name(), &dimension);
+  return solver->RevAlloc(filter);
+}
+
 LightVehicleBreaksChecker::LightVehicleBreaksChecker(
     PathState* path_state, std::vector<PathData> path_data)
     : path_state_(path_state), path_data_(std::move(path_data)) {}
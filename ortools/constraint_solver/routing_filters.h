@@ -501,6 +501,10 @@ class DimensionChecker {
   // must be called before PathState::Commit().
   void Commit();
 
+  // Replaces the capacities of the nodes, which are taken into account by
+  // Check() after the next Commit().
+  void SetNodeCapacities(const std::vector<Interval>& node_capacity);
+
   static constexpr int kOptimalMinRangeSizeForRIQ = 4;
 
  private:
@@ -528,8 +532,10 @@ class DimensionChecker {
   const std::vector<int> path_class_;
   const std::vector<std::function<Interval(int64_t, int64_t)>>
       demand_per_path_class_;
-  std::vector<ExtendedInterval> cached_demand_;
-  const std::vector<ExtendedInterval> node_capacity_;
+  std::vector<ExtendedInterval> node_capacity_;
+  // Whether the next Commit() must rebuild all structures, because node
+  // capacities changed.
+  bool needs_full_commit_ = false;
 
   // Precomputed data.
   // Maps nodes to their pre-computed data, except for isolated nodes,
@@ -558,6 +564,13 @@ class DimensionChecker {
     ExtendedInterval tsum_at_lst;
   };
   std::vector<std::vector<RIQNode>> riq_;
+  // The data of riq_[0] read by Check() on short chains, stored by field so
+  // that walking a chain reads two contiguous arrays. With i = index_[node]:
+  // - demand_to_index_[i] contains the demand from the previous node of the
+  //   path to node, or {0, 0, 0, 0} if node is a start.
+  // - capacity_of_index_[i] contains the node's capacity.
+  std::vector<ExtendedInterval> demand_to_index_;
+  std::vector<ExtendedInterval> capacity_of_index_;
   // The incremental branch of Commit() may waste space in the layers of the
   // RIQ structure. This is the upper limit of a layer's size.
   const int maximum_riq_layer_size_;
@@ -575,6 +588,12 @@ class DimensionChecker {
 LocalSearchFilter* MakeDimensionFilter(
     Solver* solver, std::unique_ptr<DimensionChecker> checker,
     absl::string_view dimension_name);
+// Same as above, for a checker of 'dimension' whose node capacities are the
+// ranges of the cumul variables: the filter restricts them by the model's
+// updates for the next solves when they change.
+LocalSearchFilter* MakeDimensionFilter(
+    Solver* solver, std::unique_ptr<DimensionChecker> checker,
+    const RoutingDimension& dimension);
 #endif  // !defined(SWIG)
 
 class LightVehicleBreaksChecker {
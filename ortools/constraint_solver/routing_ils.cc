@@ -21,11 +21,13 @@
 #include <memory>
 #include <optional>
 #include <random>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "absl/functional/bind_front.h"
 #include "absl/log/check.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "google/protobuf/repeated_ptr_field.h"
@@ -62,6 +64,8 @@ MakeGlobalCheapestInsertionParameters(
           .cheapest_insertion_first_solution_use_neighbors_ratio_for_initialization();  // NOLINT
   gci_parameters.add_unperformed_entries =
       search_parameters.cheapest_insertion_add_unperformed_entries();
+  gci_parameters.num_threads =
+      search_parameters.cheapest_insertion_num_threads();
   return gci_parameters;
 }
 
@@ -252,7 +256,10 @@ std::unique_ptr<RoutingFilteredHeuristic> MakeRecreateProcedure(
                                                     /*is_sequential=*/true);
       return std::make_unique<GlobalCheapestInsertionFilteredHeuristic>(
           model, std::move(stop_search),
-          absl::bind_front(&RoutingModel::GetArcCostForVehicle, model),
+          gci_parameters.num_threads > 1
+              ? absl::bind_front(
+                    &RoutingModel::GetArcCostForVehicleWithoutCache, model)
+              : absl::bind_front(&RoutingModel::GetArcCostForVehicle, model),
           [model](int64_t i) { return model->UnperformedPenaltyOrValue(0, i); },
           filter_manager, gci_parameters);
     }
@@ -263,7 +270,10 @@ std::unique_ptr<RoutingFilteredHeuristic> MakeRecreateProcedure(
                                                     /*is_sequential=*/false);
       return std::make_unique<GlobalCheapestInsertionFilteredHeuristic>(
           model, std::move(stop_search),
-          absl::bind_front(&RoutingModel::GetArcCostForVehicle, model),
+          gci_parameters.num_threads > 1
+              ? absl::bind_front(
+                    &RoutingModel::GetArcCostForVehicleWithoutCache, model)
+              : absl::bind_front(&RoutingModel::GetArcCostForVehicle, model),
           [model](int64_t i) { return model->UnperformedPenaltyOrValue(0, i); },
           filter_manager, gci_parameters);
     }
@@ -1096,6 +1106,51 @@ DecisionBuilder* MakeRuinAndRecreateDecisionBuilder(
       assignment, std::move(ruin), std::move(recreate)));
 }
 
+void SharedRoutingSolutionPool::Offer(
+    int worker, int64_t objective, std::vector<std::vector<int64_t>> routes) {
+  absl::MutexLock lock(&mutex_);
+  if (best_worker_ >= 0 &&
+      std::tie(objective, worker) >= std::tie(best_objective_, best_worker_)) {
+    return;
+  }
+  best_objective_ = objective;
+  best_worker_ = worker;
+  best_routes_ = std::move(routes);
+}
+
+bool SharedRoutingSolutionPool::GetBestIfBetter(
+    int64_t objective, std::vector<std::vector<int64_t>>* routes) const {
+  absl::MutexLock lock(&mutex_);
+  if (best_worker_ < 0 || best_objective_ >= objective) return false;
+  *routes = best_routes_;
+  return true;
+}
+
+void SharedRoutingSolutionPool::SynchronizeWorkers() {
+  absl::MutexLock lock(&mutex_);
+  const int64_t generation = barrier_generation_;
+  ++num_waiting_workers_;
+  MaybeReleaseWorkers();
+  const auto released = [this, generation]() {
+    mutex_.AssertReaderHeld();
+    return barrier_generation_ != generation;
+  };
+  mutex_.Await(absl::Condition(&released));
+}
+
+void SharedRoutingSolutionPool::WorkerDone() {
+  absl::MutexLock lock(&mutex_);
+  --num_active_workers_;
+  MaybeReleaseWorkers();
+}
+
+void SharedRoutingSolutionPool::MaybeReleaseWorkers() {
+  if (num_waiting_workers_ > 0 && num_waiting_workers_ >= num_active_workers_) {
+    num_waiting_workers_ = 0;
+    ++barrier_generation_;
+  }
+}
+
 DecisionBuilder* MakePerturbationDecisionBuilder(
     const RoutingSearchParameters& parameters, RoutingModel* model,
     std::mt19937* rnd, const Assignment* assignment,
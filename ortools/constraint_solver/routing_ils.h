@@ -17,11 +17,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <random>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/routing.h"
@@ -240,6 +243,51 @@ class SISRRuinProcedure : public RuinProcedure {
   RoutingSolution routing_solution_;
 };
 
+// Shares the best solution found by several iterated local search workers,
+// each running on its own copy of the same RoutingModel. Solutions are
+// exchanged as routes since the models do not share variables. Thread-safe.
+class SharedRoutingSolutionPool {
+ public:
+  explicit SharedRoutingSolutionPool(int num_workers)
+      : num_active_workers_(num_workers) {}
+
+  // This type is neither copyable nor movable.
+  SharedRoutingSolutionPool(const SharedRoutingSolutionPool&) = delete;
+  SharedRoutingSolutionPool& operator=(const SharedRoutingSolutionPool&) =
+      delete;
+
+  // Offers the solution of the given worker. It replaces the best solution if
+  // its objective is smaller, ties being broken by smallest worker index.
+  void Offer(int worker, int64_t objective,
+             std::vector<std::vector<int64_t>> routes)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Copies the best solution into 'routes' and returns true if its objective
+  // is smaller than the given one. Returns false otherwise.
+  bool GetBestIfBetter(int64_t objective,
+                       std::vector<std::vector<int64_t>>* routes) const
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Blocks until all the workers which are not done call this method.
+  void SynchronizeWorkers() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Must be called once by each worker when it stops searching.
+  void WorkerDone() ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  void MaybeReleaseWorkers() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  mutable absl::Mutex mutex_;
+  int64_t best_objective_ ABSL_GUARDED_BY(mutex_) =
+      std::numeric_limits<int64_t>::max();
+  int best_worker_ ABSL_GUARDED_BY(mutex_) = -1;
+  std::vector<std::vector<int64_t>> best_routes_ ABSL_GUARDED_BY(mutex_);
+
+  int num_active_workers_ ABSL_GUARDED_BY(mutex_);
+  int num_waiting_workers_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t barrier_generation_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
 // Returns a DecisionBuilder implementing a perturbation step of an Iterated
 // Local Search approach.
 DecisionBuilder* MakePerturbationDecisionBuilder(
@@ -79,6 +79,8 @@ IteratedLocalSearchParameters CreateDefaultIteratedLocalSearchParameters() {
   sa->set_initial_temperature(100.0);
   sa->set_final_temperature(0.01);
   sa->set_automatic_temperatures(false);
+  ils.set_num_perturbations_between_solution_sharing(10);
+  ils.set_deterministic_solution_sharing(false);
   return ils;
 }
 
@@ -98,6 +100,7 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_cheapest_insertion_first_solution_use_neighbors_ratio_for_initialization(  // NOLINT
       false);
   p.set_cheapest_insertion_add_unperformed_entries(false);
+  p.set_cheapest_insertion_num_threads(1);
   p.set_local_cheapest_insertion_pickup_delivery_strategy(
       RoutingSearchParameters::BEST_PICKUP_THEN_BEST_DELIVERY);
   p.set_local_cheapest_cost_insertion_pickup_delivery_strategy(
@@ -181,6 +184,11 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_use_iterated_local_search(false);
   *p.mutable_iterated_local_search_parameters() =
       CreateDefaultIteratedLocalSearchParameters();
+  RoutingSearchParameters::RouteDecompositionParameters* const decomposition =
+      p.mutable_route_decomposition_parameters();
+  decomposition->set_num_routes_per_subproblem(4);
+  decomposition->mutable_subproblem_time_limit()->set_seconds(1);
+  decomposition->set_max_rounds(10);
 
   const std::string error = FindErrorInRoutingSearchParameters(p);
   LOG_IF(DFATAL, !error.empty())
@@ -531,6 +539,13 @@ std::vector<std::string> FindErrorsInRoutingSearchParameters(
         "Invalid cheapest_insertion_ls_operator_min_neighbors: ", min_neighbors,
         ". Must be greater or equal to 1."));
   }
+  if (const int32_t num_threads =
+          search_parameters.cheapest_insertion_num_threads();
+      num_threads < 1) {
+    errors.emplace_back(
+        StrCat("Invalid cheapest_insertion_num_threads: ", num_threads,
+               ". Must be greater or equal to 1."));
+  }
   {
     absl::flat_hash_map<RoutingSearchParameters::InsertionSortingProperty, int>
         sorting_properties_map;
@@ -612,6 +627,25 @@ std::vector<std::string> FindErrorsInRoutingSearchParameters(
         "Invalid lns_time_limit: " +
         ProtobufShortDebugString(search_parameters.lns_time_limit()));
   }
+  {
+    const RoutingSearchParameters::RouteDecompositionParameters&
+        decomposition = search_parameters.route_decomposition_parameters();
+    if (const int32_t num_routes = decomposition.num_routes_per_subproblem();
+        num_routes < 1) {
+      errors.emplace_back(StrCat(
+          "Invalid route_decomposition_parameters.num_routes_per_subproblem: ",
+          num_routes));
+    }
+    if (!IsValidNonNegativeDuration(decomposition.subproblem_time_limit())) {
+      errors.emplace_back(
+          "Invalid route_decomposition_parameters.subproblem_time_limit: " +
+          ProtobufShortDebugString(decomposition.subproblem_time_limit()));
+    }
+    if (const int32_t max_rounds = decomposition.max_rounds(); max_rounds < 0) {
+      errors.emplace_back(StrCat(
+          "Invalid route_decomposition_parameters.max_rounds: ", max_rounds));
+    }
+  }
   if (const double ratio = search_parameters.secondary_ls_time_limit_ratio();
       std::isnan(ratio) || ratio < 0 || ratio >= 1) {
     errors.emplace_back(
@@ -45,6 +45,7 @@
 #include "absl/log/die_if_null.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "ortools/base/adjustable_priority_queue.h"
@@ -53,6 +54,7 @@
 #include "ortools/base/mathutil.h"
 #include "ortools/base/protoutil.h"
 #include "ortools/base/stl_util.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
@@ -982,6 +984,10 @@ bool GlobalCheapestInsertionFilteredHeuristic::BuildSolutionInternal() {
     empty_vehicle_type_curator_ = std::make_unique<VehicleTypeCurator>(
         model()->GetVehicleTypeContainer());
   }
+  if (gci_params_.num_threads > 1 && thread_pool_ == nullptr) {
+    thread_pool_ = std::make_unique<ThreadPool>(gci_params_.num_threads);
+    thread_pool_->StartWorkers();
+  }
   // Store all empty vehicles in the empty_vehicle_type_curator_.
   empty_vehicle_type_curator_->Reset(
       [this](int vehicle) { return VehicleIsEmpty(vehicle); });
@@ -2217,6 +2223,8 @@ bool GlobalCheapestInsertionFilteredHeuristic::InitializePositions(
     const SparseBitset<int>& nodes, const absl::flat_hash_set<int>& vehicles,
     NodeEntryQueue* queue) {
   queue->Clear();
+  // Drop the entries left by a call interrupted by StopSearch().
+  pending_node_entries_.clear();
 
   const int num_vehicles =
       vehicles.empty() ? model()->vehicles() : vehicles.size();
@@ -2234,6 +2242,7 @@ bool GlobalCheapestInsertionFilteredHeuristic::InitializePositions(
     // Add all insertion entries making node performed.
     InitializeInsertionEntriesPerformingNode(node, vehicles, queue);
   }
+  FlushPendingNodeEntries(all_vehicles, queue);
   return true;
 }
 
@@ -2340,6 +2349,7 @@ bool GlobalCheapestInsertionFilteredHeuristic::AddNodeEntriesAfter(
   // Remove existing entries at 'insert_after', needed either when updating
   // entries or if unperformed node insertions were present.
   queue->ClearInsertions(insert_after);
+  pending_node_entries_.clear();
   const std::vector<int>& neighbors =
       node_index_to_neighbors_by_cost_class_
           ->GetOutgoingNeighborsOfNodeForCostClass(cost_class, insert_after);
@@ -2362,6 +2372,7 @@ bool GlobalCheapestInsertionFilteredHeuristic::AddNodeEntriesAfter(
       }
     }
   }
+  FlushPendingNodeEntries(all_vehicles, queue);
   return true;
 }
 
@@ -2400,6 +2411,12 @@ void GlobalCheapestInsertionFilteredHeuristic::AddNodeEntry(
                          CapSub(node_penalty, penalty_shift));
     return;
   }
+  if (thread_pool_ != nullptr) {
+    pending_node_entries_.push_back({node, insert_after, vehicle,
+                                     num_allowed_vehicles, node_penalty,
+                                     penalty_shift, /*insertion_cost=*/0});
+    return;
+  }
 
   const int64_t insertion_cost = GetInsertionCostForNodeAtPosition(
       node, insert_after, Value(insert_after), vehicle);
@@ -2414,6 +2431,51 @@ void GlobalCheapestInsertionFilteredHeuristic::AddNodeEntry(
                        CapSub(insertion_cost, penalty_shift));
 }
 
+void GlobalCheapestInsertionFilteredHeuristic::FlushPendingNodeEntries(
+    bool all_vehicles, NodeEntryQueue* queue) {
+  if (pending_node_entries_.empty()) return;
+  const auto compute_insertion_costs = [this](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      PendingNodeEntry& entry = pending_node_entries_[i];
+      entry.insertion_cost = GetInsertionCostForNodeAtPosition(
+          entry.node, entry.insert_after, Value(entry.insert_after),
+          entry.vehicle);
+    }
+  };
+  // Each entry only costs a few evaluator calls, so small batches are not
+  // worth dispatching to the thread pool.
+  constexpr int kMinEntriesPerBlock = 64;
+  const int num_entries = pending_node_entries_.size();
+  const int num_blocks = std::min(num_entries / kMinEntriesPerBlock,
+                                  4 * gci_params_.num_threads);
+  if (num_blocks <= 1) {
+    compute_insertion_costs(0, num_entries);
+  } else {
+    absl::BlockingCounter counter(num_blocks);
+    for (int block = 0; block < num_blocks; ++block) {
+      const int begin = static_cast<int64_t>(num_entries) * block / num_blocks;
+      const int end =
+          static_cast<int64_t>(num_entries) * (block + 1) / num_blocks;
+      thread_pool_->Schedule([&compute_insertion_costs, &counter, begin,
+                              end]() {
+        compute_insertion_costs(begin, end);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+  // The entries are pushed in the order in which they were created, and the
+  // queue sorts them anyway, so the result does not depend on the threads.
+  for (const PendingNodeEntry& entry : pending_node_entries_) {
+    // See the corresponding NOTE in AddNodeEntry().
+    if (!all_vehicles && entry.insertion_cost > entry.node_penalty) continue;
+    queue->PushInsertion(entry.node, entry.insert_after, entry.vehicle,
+                         entry.num_allowed_vehicles,
+                         CapSub(entry.insertion_cost, entry.penalty_shift));
+  }
+  pending_node_entries_.clear();
+}
+
 void InsertionSequenceGenerator::AppendPickupDeliveryMultitourInsertions(
     int pickup, int delivery, int vehicle, const std::vector<int>& path,
     const std::vector<bool>& path_node_is_pickup,
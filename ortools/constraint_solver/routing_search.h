@@ -39,6 +39,7 @@
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "ortools/base/adjustable_priority_queue.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
 #include "ortools/constraint_solver/routing.h"
@@ -526,6 +527,9 @@ class GlobalCheapestInsertionFilteredHeuristic
     /// the node/pair will be made unperformed. If false, only entries making
     /// a node/pair performed are considered.
     bool add_unperformed_entries;
+    /// Number of threads used to compute the insertion costs of node entries.
+    /// If greater than 1, the evaluator must be thread-safe.
+    int num_threads = 1;
   };
 
   /// Takes ownership of evaluators.
@@ -868,8 +872,13 @@ class GlobalCheapestInsertionFilteredHeuristic
   /// Creates a NodeEntry corresponding to the insertion of 'node' after
   /// 'insert_after' on 'vehicle' and adds it to the 'queue' and
   /// 'node_entries'.
+  /// When gci_params_.num_threads > 1, the insertion cost of the entry is not
+  /// computed here and the entry is added to pending_node_entries_ instead.
   void AddNodeEntry(int64_t node, int64_t insert_after, int vehicle,
                     bool all_vehicles, NodeEntryQueue* queue) const;
+  /// Computes the insertion costs of the pending node entries on the thread
+  /// pool, and adds the entries to the 'queue'.
+  void FlushPendingNodeEntries(bool all_vehicles, NodeEntryQueue* queue);
 
   void ResetVehicleIndices() override {
     node_index_to_vehicle_.assign(node_index_to_vehicle_.size(), -1);
@@ -925,6 +934,20 @@ class GlobalCheapestInsertionFilteredHeuristic
   std::unique_ptr<VehicleTypeCurator> empty_vehicle_type_curator_;
 
   mutable EntryAllocator<PairEntry> pair_entry_allocator_;
+
+  /// Node entry waiting for its insertion cost, see AddNodeEntry().
+  struct PendingNodeEntry {
+    int64_t node;
+    int64_t insert_after;
+    int vehicle;
+    int num_allowed_vehicles;
+    int64_t node_penalty;
+    int64_t penalty_shift;
+    int64_t insertion_cost;
+  };
+  mutable std::vector<PendingNodeEntry> pending_node_entries_;
+  /// Only created when gci_params_.num_threads > 1.
+  std::unique_ptr<ThreadPool> thread_pool_;
 };
 
 // Holds sequences of insertions.
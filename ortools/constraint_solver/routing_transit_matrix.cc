@@ -0,0 +1,218 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/routing_transit_matrix.h"
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // !_MSC_VER
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace operations_research {
+
+namespace {
+
+// The file starts with kHeaderSize int64 values: kMagic, the number of nodes,
+// the value type, and the min and max values. The values follow, row-major.
+constexpr int64_t kMagic = 0x5452544D54524F;  // "ORTRMTR"
+constexpr int kHeaderSize = 5;
+constexpr size_t kHeaderBytes = kHeaderSize * sizeof(int64_t);
+
+size_t BytesPerValue(RoutingTransitMatrix::ValueType type) {
+  switch (type) {
+    case RoutingTransitMatrix::ValueType::kUInt16:
+      return sizeof(uint16_t);
+    case RoutingTransitMatrix::ValueType::kInt32:
+      return sizeof(int32_t);
+    default:
+      return sizeof(int64_t);
+  }
+}
+
+}  // namespace
+
+RoutingTransitMatrix::RoutingTransitMatrix(
+    absl::Span<const std::vector<int64_t>> values) {
+  const int num_nodes = values.size();
+  for (const std::vector<int64_t>& row : values) {
+    CHECK_EQ(row.size(), num_nodes);
+  }
+  Initialize(num_nodes,
+             [values](int from, int to) { return values[from][to]; });
+}
+
+RoutingTransitMatrix::RoutingTransitMatrix(int num_nodes,
+                                           absl::Span<const int64_t> values) {
+  CHECK_EQ(values.size(), static_cast<size_t>(num_nodes) * num_nodes);
+  Initialize(num_nodes, [values, num_nodes](int from, int to) {
+    return values[static_cast<size_t>(from) * num_nodes + to];
+  });
+}
+
+RoutingTransitMatrix::~RoutingTransitMatrix() {
+#if !defined(_MSC_VER)
+  if (mapped_address_ != nullptr) munmap(mapped_address_, mapped_size_);
+#endif  // !_MSC_VER
+}
+
+template <typename ValueGetter>
+void RoutingTransitMatrix::Initialize(int num_nodes,
+                                      const ValueGetter& get_value) {
+  num_nodes_ = num_nodes;
+  min_value_ = num_nodes > 0 ? std::numeric_limits<int64_t>::max() : 0;
+  max_value_ = num_nodes > 0 ? std::numeric_limits<int64_t>::min() : 0;
+  for (int from = 0; from < num_nodes; ++from) {
+    for (int to = 0; to < num_nodes; ++to) {
+      const int64_t value = get_value(from, to);
+      min_value_ = std::min(min_value_, value);
+      max_value_ = std::max(max_value_, value);
+    }
+  }
+  if (min_value_ >= 0 && max_value_ <= std::numeric_limits<uint16_t>::max()) {
+    value_type_ = ValueType::kUInt16;
+  } else if (min_value_ >= std::numeric_limits<int32_t>::min() &&
+             max_value_ <= std::numeric_limits<int32_t>::max()) {
+    value_type_ = ValueType::kInt32;
+  } else {
+    value_type_ = ValueType::kInt64;
+  }
+
+  // Allocating int64_t words guarantees the alignment of all the types.
+  const size_t num_words = (NumBytes() + sizeof(int64_t) - 1) / sizeof(int64_t);
+  owned_data_ = std::make_unique<int64_t[]>(num_words);
+  data_ = owned_data_.get();
+  size_t position = 0;
+  for (int from = 0; from < num_nodes; ++from) {
+    for (int to = 0; to < num_nodes; ++to, ++position) {
+      const int64_t value = get_value(from, to);
+      switch (value_type_) {
+        case ValueType::kUInt16:
+          reinterpret_cast<uint16_t*>(owned_data_.get())[position] = value;
+          break;
+        case ValueType::kInt32:
+          reinterpret_cast<int32_t*>(owned_data_.get())[position] = value;
+          break;
+        default:
+          owned_data_[position] = value;
+      }
+    }
+  }
+}
+
+size_t RoutingTransitMatrix::NumBytes() const {
+  return static_cast<size_t>(num_nodes_) * num_nodes_ *
+         BytesPerValue(value_type_);
+}
+
+absl::StatusOr<std::unique_ptr<RoutingTransitMatrix>>
+RoutingTransitMatrix::LoadFromFile(absl::string_view filename) {
+  const std::string name(filename);
+  std::ifstream input(name, std::ios::binary);
+  if (!input) {
+    return absl::NotFoundError(absl::StrCat("Could not open '", name, "'."));
+  }
+  int64_t header[kHeaderSize];
+  if (!input.read(reinterpret_cast<char*>(header), kHeaderBytes)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Could not read the header of '", name, "'."));
+  }
+  if (header[0] != kMagic || header[1] < 0 || header[2] < 0 || header[2] > 2) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("'", name, "' is not a transit matrix file."));
+  }
+
+  // Using new to access the private constructor.
+  std::unique_ptr<RoutingTransitMatrix> matrix(new RoutingTransitMatrix());
+  matrix->num_nodes_ = header[1];
+  matrix->value_type_ = static_cast<ValueType>(header[2]);
+  matrix->min_value_ = header[3];
+  matrix->max_value_ = header[4];
+  const size_t num_bytes = matrix->NumBytes();
+
+  input.seekg(0, std::ios::end);
+  const size_t file_size = input.tellg();
+  if (file_size != kHeaderBytes + num_bytes) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "'", name, "' has ", file_size, " bytes, expected ",
+        kHeaderBytes + num_bytes, "."));
+  }
+
+#if !defined(_MSC_VER)
+  input.close();
+  const int fd = open(name.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    void* address = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address != MAP_FAILED) {
+      matrix->mapped_address_ = address;
+      matrix->mapped_size_ = file_size;
+      matrix->data_ = static_cast<const char*>(address) + kHeaderBytes;
+      return matrix;
+    }
+  }
+  // Fall back to reading the file.
+  input.open(name, std::ios::binary);
+#endif  // !_MSC_VER
+
+  const size_t num_words = (num_bytes + sizeof(int64_t) - 1) / sizeof(int64_t);
+  matrix->owned_data_ = std::make_unique<int64_t[]>(num_words);
+  matrix->data_ = matrix->owned_data_.get();
+  input.seekg(kHeaderBytes, std::ios::beg);
+  if (!input.read(reinterpret_cast<char*>(matrix->owned_data_.get()),
+                  num_bytes)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Could not read the values of '", name, "'."));
+  }
+  return matrix;
+}
+
+absl::Status RoutingTransitMatrix::WriteToFile(
+    absl::string_view filename) const {
+  const std::string name(filename);
+  std::ofstream output(name, std::ios::binary | std::ios::trunc);
+  if (!output) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Could not open '", name, "' for writing."));
+  }
+  const int64_t header[kHeaderSize] = {kMagic, num_nodes_,
+                                       static_cast<int64_t>(value_type_),
+                                       min_value_, max_value_};
+  output.write(reinterpret_cast<const char*>(header), kHeaderBytes);
+  output.write(static_cast<const char*>(data_), NumBytes());
+  output.close();
+  if (!output) {
+    return absl::InternalError(
+        absl::StrCat("Could not write to '", name, "'."));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace operations_research
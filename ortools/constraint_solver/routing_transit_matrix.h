@@ -0,0 +1,130 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_TRANSIT_MATRIX_H_
+#define OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_TRANSIT_MATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace operations_research {
+
+// A dense matrix of transit values between nodes, to be registered with
+// RoutingModel::RegisterCompactTransitMatrix().
+//
+// The values are stored row-major in a single buffer, with the smallest
+// integer type that represents all of them exactly: a 30k nodes matrix of
+// travel times in seconds takes 1.8GB as uint16 instead of 7.2GB as int64.
+// The matrix can also be memory-mapped from a file written by WriteToFile(),
+// in which case the pages are only loaded when accessed and are shared by all
+// the processes using the same file.
+//
+// Once registered in a RoutingModel, the routing hot paths (arc costs,
+// dimension transits, cumul filters) read the matrix directly with
+// Evaluate() instead of calling a std::function.
+class RoutingTransitMatrix {
+ public:
+  enum class ValueType : int64_t { kInt64 = 0, kInt32 = 1, kUInt16 = 2 };
+
+  // Builds the matrix from values[from_node][to_node]. All the rows must have
+  // values.size() elements.
+  explicit RoutingTransitMatrix(absl::Span<const std::vector<int64_t>> values);
+
+  // Same as above from the row-major values of a num_nodes x num_nodes matrix.
+  RoutingTransitMatrix(int num_nodes, absl::Span<const int64_t> values);
+
+  ~RoutingTransitMatrix();
+
+  // This type is neither copyable nor movable.
+  RoutingTransitMatrix(const RoutingTransitMatrix&) = delete;
+  RoutingTransitMatrix& operator=(const RoutingTransitMatrix&) = delete;
+
+  // Loads a matrix written by WriteToFile(). The file is memory-mapped on the
+  // platforms supporting it, and read otherwise. Note that the values are
+  // stored with the native endianness.
+  static absl::StatusOr<std::unique_ptr<RoutingTransitMatrix>> LoadFromFile(
+      absl::string_view filename);
+  absl::Status WriteToFile(absl::string_view filename) const;
+
+  int num_nodes() const { return num_nodes_; }
+  ValueType value_type() const { return value_type_; }
+  int64_t min_value() const { return min_value_; }
+  int64_t max_value() const { return max_value_; }
+  bool is_memory_mapped() const { return mapped_size_ > 0; }
+
+  int64_t Get(int64_t from_node, int64_t to_node) const {
+    DCHECK_LT(from_node, num_nodes_);
+    DCHECK_LT(to_node, num_nodes_);
+    const int64_t position = from_node * num_nodes_ + to_node;
+    switch (value_type_) {
+      case ValueType::kUInt16:
+        return static_cast<const uint16_t*>(data_)[position];
+      case ValueType::kInt32:
+        return static_cast<const int32_t*>(data_)[position];
+      default:
+        return static_cast<const int64_t*>(data_)[position];
+    }
+  }
+
+  // Same as Get() but on the variable indices of the RoutingModel in which
+  // this matrix is registered.
+  int64_t Evaluate(int64_t from_index, int64_t to_index) const {
+    DCHECK_LT(from_index, index_to_node_.size());
+    DCHECK_LT(to_index, index_to_node_.size());
+    return Get(index_to_node_[from_index], index_to_node_[to_index]);
+  }
+
+ private:
+  friend class RoutingModel;
+
+  RoutingTransitMatrix() = default;
+
+  // Fills min_value_, max_value_ and value_type_, and copies the values in a
+  // newly allocated buffer of the right type.
+  template <typename ValueGetter>
+  void Initialize(int num_nodes, const ValueGetter& get_value);
+
+  // The size of the values buffer.
+  size_t NumBytes() const;
+
+  // Called by the RoutingModel on registration.
+  void SetIndexToNode(std::vector<int> index_to_node) {
+    index_to_node_ = std::move(index_to_node);
+  }
+
+  int64_t num_nodes_ = 0;
+  ValueType value_type_ = ValueType::kInt64;
+  int64_t min_value_ = 0;
+  int64_t max_value_ = 0;
+
+  // Points either to owned_data_ or inside the mapped file.
+  const void* data_ = nullptr;
+  std::unique_ptr<int64_t[]> owned_data_;
+  void* mapped_address_ = nullptr;
+  size_t mapped_size_ = 0;
+
+  std::vector<int> index_to_node_;
+};
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_TRANSIT_MATRIX_H_
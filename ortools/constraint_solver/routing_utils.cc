@@ -14,6 +14,7 @@
 #include "ortools/constraint_solver/routing_utils.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <queue>
 #include <tuple>
@@ -173,4 +174,77 @@ bool FindMostExpensiveArcsOnRoute(
   return true;
 }
 
+PointKdTree::PointKdTree(absl::Span<const std::pair<int64_t, int64_t>> points,
+                         std::vector<int> ids)
+    : points_(points), ids_(std::move(ids)) {
+  Build(0, ids_.size(), 0);
+}
+
+void PointKdTree::Build(int begin, int end, int depth) {
+  if (end - begin <= 1) return;
+  const int middle = begin + (end - begin) / 2;
+  const bool split_on_x = depth % 2 == 0;
+  std::nth_element(ids_.begin() + begin, ids_.begin() + middle,
+                   ids_.begin() + end, [this, split_on_x](int a, int b) {
+                     const auto& [ax, ay] = points_[a];
+                     const auto& [bx, by] = points_[b];
+                     return split_on_x ? std::tie(ax, a) < std::tie(bx, b)
+                                       : std::tie(ay, a) < std::tie(by, b);
+                   });
+  Build(begin, middle, depth + 1);
+  Build(middle + 1, end, depth + 1);
+}
+
+void PointKdTree::FindNearest(int64_t x, int64_t y, int k,
+                              std::vector<int>* nearest) const {
+  nearest->clear();
+  if (k <= 0) return;
+  // Max-heap of the (squared distance, id) of the best points found so far.
+  std::vector<std::pair<double, int>> heap;
+  heap.reserve(k + 1);
+  Search(0, ids_.size(), 0, x, y, k, &heap);
+  std::sort_heap(heap.begin(), heap.end());
+  nearest->reserve(heap.size());
+  for (const auto& [distance, id] : heap) nearest->push_back(id);
+}
+
+void PointKdTree::Search(int begin, int end, int depth, int64_t x, int64_t y,
+                         int k,
+                         std::vector<std::pair<double, int>>* heap) const {
+  if (begin >= end) return;
+  const int middle = begin + (end - begin) / 2;
+  const int id = ids_[middle];
+  const auto& [px, py] = points_[id];
+  // Doubles avoid overflows on large coordinates.
+  const double dx = static_cast<double>(x) - static_cast<double>(px);
+  const double dy = static_cast<double>(y) - static_cast<double>(py);
+  const std::pair<double, int> candidate = {dx * dx + dy * dy, id};
+  if (heap->size() < k) {
+    heap->push_back(candidate);
+    std::push_heap(heap->begin(), heap->end());
+  } else if (candidate < heap->front()) {
+    std::pop_heap(heap->begin(), heap->end());
+    heap->back() = candidate;
+    std::push_heap(heap->begin(), heap->end());
+  }
+
+  // Explore the side of the split containing (x, y) first, and the other side
+  // only if it can contain a point closer than the current k-th one.
+  const double split_distance = depth % 2 == 0 ? dx : dy;
+  const bool left_first = split_distance < 0;
+  if (left_first) {
+    Search(begin, middle, depth + 1, x, y, k, heap);
+  } else {
+    Search(middle + 1, end, depth + 1, x, y, k, heap);
+  }
+  if (heap->size() < k ||
+      split_distance * split_distance <= heap->front().first) {
+    if (left_first) {
+      Search(middle + 1, end, depth + 1, x, y, k, heap);
+    } else {
+      Search(begin, middle, depth + 1, x, y, k, heap);
+    }
+  }
+}
+
 }  // namespace operations_research
@@ -89,6 +89,33 @@ bool FindMostExpensiveArcsOnRoute(
     std::vector<std::pair<int64_t, int>>* most_expensive_arc_starts_and_ranks,
     std::pair<int, int>* first_expensive_arc_indices);
 
+// A static 2-d tree over a set of points, to find the nearest points of a
+// given point with respect to the Euclidean distance. Queries are thread-safe.
+class PointKdTree {
+ public:
+  // Indexes the points[id] for all the given ids. The points must outlive the
+  // tree.
+  PointKdTree(absl::Span<const std::pair<int64_t, int64_t>> points,
+              std::vector<int> ids);
+
+  int size() const { return ids_.size(); }
+
+  // Fills 'nearest' with the ids of the min(k, size()) nearest points to
+  // (x, y), sorted by increasing distance, ties broken by increasing id.
+  void FindNearest(int64_t x, int64_t y, int k,
+                   std::vector<int>* nearest) const;
+
+ private:
+  // The subtree on ids_[begin, end) is split on the point at the middle of the
+  // range, along x at even depths and along y at odd depths.
+  void Build(int begin, int end, int depth);
+  void Search(int begin, int end, int depth, int64_t x, int64_t y, int k,
+              std::vector<std::pair<double, int>>* heap) const;
+
+  const absl::Span<const std::pair<int64_t, int64_t>> points_;
+  std::vector<int> ids_;
+};
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_UTILS_H_
@@ -0,0 +1,109 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the trail compression schemes on a deep search: the time and the
+// packed size of the trail per choice point.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/solver_parameters.pb.h"
+
+namespace operations_research {
+namespace {
+
+// Records the largest packed size of the trail during a search, and the
+// number of choice points on the path to the node where it was reached.
+class TrailSizeMonitor : public SearchMonitor {
+ public:
+  explicit TrailSizeMonitor(Solver* solver) : SearchMonitor(solver) {}
+
+  void AfterDecision(Decision*, bool) override {
+    const int64_t packed_bytes = solver()->TrailPackedBytes();
+    if (packed_bytes > max_packed_bytes_) {
+      max_packed_bytes_ = packed_bytes;
+      depth_at_max_ = solver()->SearchDepth();
+    }
+  }
+  std::string DebugString() const override { return "TrailSizeMonitor"; }
+
+  double BytesPerChoicePoint() const {
+    return depth_at_max_ == 0
+               ? 0.0
+               : static_cast<double>(max_packed_bytes_) / depth_at_max_;
+  }
+
+ private:
+  int64_t max_packed_bytes_ = 0;
+  int depth_at_max_ = 0;
+};
+
+// Explores the first 'num_branches' branches of the n-queens problem, with a
+// static variable order to get a deep search tree whose nodes modify many
+// reversible values. Returns the packed size of the trail per choice point, at
+// the node where the trail is the largest.
+double ExploreQueens(ConstraintSolverParameters::TrailCompression compression,
+                     int num_queens, int64_t num_branches) {
+  ConstraintSolverParameters parameters = Solver::DefaultSolverParameters();
+  parameters.set_compress_trail(compression);
+  Solver solver("queens", parameters);
+  std::vector<IntVar*> queens;
+  std::vector<IntVar*> diagonals;
+  std::vector<IntVar*> anti_diagonals;
+  solver.MakeIntVarArray(num_queens, 0, num_queens - 1, "queen", &queens);
+  for (int i = 0; i < num_queens; ++i) {
+    diagonals.push_back(solver.MakeSum(queens[i], i)->Var());
+    anti_diagonals.push_back(solver.MakeSum(queens[i], -i)->Var());
+  }
+  solver.AddConstraint(solver.MakeAllDifferent(queens));
+  solver.AddConstraint(solver.MakeAllDifferent(diagonals));
+  solver.AddConstraint(solver.MakeAllDifferent(anti_diagonals));
+  DecisionBuilder* const db = solver.MakePhase(
+      queens, Solver::CHOOSE_FIRST_UNBOUND, Solver::ASSIGN_CENTER_VALUE);
+
+  TrailSizeMonitor* const trail_size =
+      solver.RevAlloc(new TrailSizeMonitor(&solver));
+  solver.Solve(db, solver.MakeBranchesLimit(num_branches), trail_size);
+  return trail_size->BytesPerChoicePoint();
+}
+
+template <ConstraintSolverParameters::TrailCompression compression>
+static void BM_QueensTrail(benchmark::State& state) {
+  const int num_queens = state.range(0);
+  const int64_t num_branches = state.range(1);
+  double bytes_per_choice_point = 0;
+  for (auto _ : state) {
+    bytes_per_choice_point +=
+        ExploreQueens(compression, num_queens, num_branches);
+  }
+  state.SetItemsProcessed(state.iterations() * num_branches);
+  state.counters["bytes_per_choice_point"] = benchmark::Counter(
+      bytes_per_choice_point, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_QueensTrail<ConstraintSolverParameters::NO_COMPRESSION>)
+    ->ArgPair(/*num_queens*/ 200, /*num_branches*/ 100000)
+    ->ArgPair(/*num_queens*/ 2000, /*num_branches*/ 100000);
+BENCHMARK(BM_QueensTrail<ConstraintSolverParameters::COMPRESS_WITH_ZLIB>)
+    ->ArgPair(/*num_queens*/ 200, /*num_branches*/ 100000)
+    ->ArgPair(/*num_queens*/ 2000, /*num_branches*/ 100000);
+BENCHMARK(
+    BM_QueensTrail<ConstraintSolverParameters::COMPRESS_WITH_DELTA_VARINT>)
+    ->ArgPair(/*num_queens*/ 200, /*num_branches*/ 100000)
+    ->ArgPair(/*num_queens*/ 2000, /*num_branches*/ 100000);
+
+}  // namespace
+}  // namespace operations_research
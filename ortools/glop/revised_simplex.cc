@@ -164,19 +164,38 @@ Status RevisedSimplex::MinimizeFromTransposedMatrixWithSlack(
   PropagateParameters();
 
   // The source of truth is the transposed matrix.
+  bool only_change_is_new_rows = false;
   if (transpose_was_changed_) {
+    const RowIndex old_num_rows = num_rows_;
+    const ColIndex old_first_slack_col = first_slack_col_;
     compact_matrix_.PopulateFromTranspose(transposed_matrix_);
     num_rows_ = compact_matrix_.num_rows();
     num_cols_ = compact_matrix_.num_cols();
     first_slack_col_ = num_cols_ - RowToColIndex(num_rows_);
+    only_change_is_new_rows = transpose_only_has_new_rows_ &&
+                              num_rows_ > old_num_rows &&
+                              first_slack_col_ == old_first_slack_col;
   }
 
   DCHECK_EQ(num_cols_, objective.size());
 
-  // Copy objective
+  // Copy objective. Note that when we only added new rows, the objective is
+  // still considered unchanged if it is the same on the old columns and zero
+  // on the new slacks.
   objective_scaling_factor_ = objective_scaling_factor;
   objective_offset_ = objective_offset;
-  const bool objective_is_unchanged = objective_ == objective;
+  bool objective_is_unchanged = objective_ == objective;
+  if (only_change_is_new_rows && objective_.size() < objective.size()) {
+    const ColIndex old_num_cols = objective_.size();
+    objective_is_unchanged = true;
+    for (ColIndex col(0); col < objective.size(); ++col) {
+      const Fractional old_value = col < old_num_cols ? objective_[col] : 0.0;
+      if (objective[col] != old_value) {
+        objective_is_unchanged = false;
+        break;
+      }
+    }
+  }
   objective_ = objective;
   InitializeObjectiveLimit();
 
@@ -193,6 +212,25 @@ Status RevisedSimplex::MinimizeFromTransposedMatrixWithSlack(
     variable_values_.ResetAllNonBasicVariableValues(variable_starting_values_);
     variable_values_.RecomputeBasicVariableValues();
     return SolveInternal(start_time, false, objective, time_limit);
+  } else if (objective_is_unchanged && parameters_.use_dual_simplex() &&
+             only_change_is_new_rows &&
+             !solution_state_has_been_set_externally_ &&
+             !solution_state_.IsEmpty()) {
+    // Same as what we do in Initialize() when new rows are added: the new
+    // slacks are appended to the current basis, and only the norms of the new
+    // rows need to be initialized.
+    primal_edge_norms_.Clear();
+    variables_info_.InitializeFromBasisState(first_slack_col_, ColIndex(0),
+                                             solution_state_);
+    dual_edge_norms_.ResizeOnNewRows(num_rows_);
+    reduced_costs_.ClearAndRemoveCostShifts();
+    dual_pricing_vector_.clear();
+    if (InitializeFirstBasis(basis_).ok()) {
+      transpose_was_changed_ = false;
+      transpose_only_has_new_rows_ = false;
+      return SolveInternal(start_time, false, objective, time_limit);
+    }
+    GLOP_RETURN_IF_ERROR(FinishInitialization(true));
   } else {
     GLOP_RETURN_IF_ERROR(FinishInitialization(true));
   }
@@ -1639,6 +1677,7 @@ Status RevisedSimplex::FinishInitialization(bool solve_from_scratch) {
   DCHECK(BasisIsConsistent());
 
   transpose_was_changed_ = false;
+  transpose_only_has_new_rows_ = false;
   return Status::OK();
 }
 
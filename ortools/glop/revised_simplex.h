@@ -253,6 +253,23 @@ class RevisedSimplex {
   // internal data of glop and then call solve.
   const CompactSparseMatrix& MatrixWithSlack() const { return compact_matrix_; }
   CompactSparseMatrix* MutableTransposedMatrixWithSlack() {
+    transpose_was_changed_ = true;
+    transpose_only_has_new_rows_ = false;
+    return &transposed_matrix_;
+  }
+
+  // Same as MutableTransposedMatrixWithSlack() except that the caller promises
+  // to only append new columns to the transposed matrix, that is new rows (with
+  // their slack) after the existing ones. The bounds must be resized
+  // accordingly and the objective must stay the same on the old columns.
+  //
+  // With the dual simplex, the next MinimizeFromTransposedMatrixWithSlack()
+  // can then warm-start from the current basis extended with the new slacks
+  // and keep the dual edge norms of the old rows instead of reinitializing
+  // everything like after a generic matrix change. This is what we want when
+  // adding cuts.
+  CompactSparseMatrix* MutableTransposedMatrixWithSlackForNewRows() {
+    if (!transpose_was_changed_) transpose_only_has_new_rows_ = true;
     transpose_was_changed_ = true;
     return &transposed_matrix_;
   }
@@ -734,8 +751,10 @@ class RevisedSimplex {
   // If this is cleared, we assume they are none.
   DenseRow variable_starting_values_;
 
-  // See MutableTransposedMatrixWithSlack().
+  // See MutableTransposedMatrixWithSlack() and
+  // MutableTransposedMatrixWithSlackForNewRows().
   bool transpose_was_changed_ = false;
+  bool transpose_only_has_new_rows_ = false;
 
   // This is known as 'd' in the literature and is set during each pivot to the
   // right inverse of the basic entering column of A by ComputeDirection().
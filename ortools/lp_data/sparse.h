@@ -369,6 +369,14 @@ class CompactSparseMatrix {
   // Add*() functions below.
   void Reset(RowIndex num_rows);
 
+  // Increases the number of rows without touching the existing columns, so
+  // that the Add*() functions below can refer to the new rows. The new number
+  // of rows must not be smaller than the current one.
+  void IncreaseNumRows(RowIndex num_rows) {
+    DCHECK_GE(num_rows, num_rows_);
+    num_rows_ = num_rows;
+  }
+
   // Api to add columns one at the time.
   void AddEntryToCurrentColumn(RowIndex row, Fractional coeff);
   void CloseCurrentColumn();
@@ -1177,8 +1177,7 @@ void BinaryImplicationGraph::RemoveFixedVariables() {
 
 class SccGraph {
  public:
-  using Implications =
-      util_intops::StrongVector<LiteralIndex, absl::InlinedVector<Literal, 6>>;
+  using Implications = CompactVectorVector<LiteralIndex, Literal>;
   using AtMostOnes =
       util_intops::StrongVector<LiteralIndex, absl::InlinedVector<int32_t, 6>>;
   using SccFinder =
@@ -1303,12 +1302,14 @@ bool BinaryImplicationGraph::DetectEquivalences(bool log_info) {
   CompactVectorVector<int32_t, int32_t> scc;
   scc.reserve(size);
   double dtime = 0.0;
+  const int64_t compact_bytes = BuildCompactImplications();
   {
     SccGraph::SccFinder finder;
-    SccGraph graph(&finder, &implications_, &at_most_ones_,
+    SccGraph graph(&finder, &compact_implications_, &at_most_ones_,
                    &at_most_one_buffer_);
     finder.FindStronglyConnectedComponents(size, graph, &scc);
     dtime += 4e-8 * graph.work_done_;
+    compact_implications_.clear();
 
     for (const Literal l : graph.to_fix_) {
       if (assignment.LiteralIsFalse(l)) return false;
@@ -1477,6 +1478,7 @@ bool BinaryImplicationGraph::DetectEquivalences(bool log_info) {
                          << implications_.size() << " literals."
                          << " size of at_most_one buffer = "
                          << at_most_one_buffer_.size() << "."
+                         << " compact copy: " << compact_bytes << " bytes."
                          << " dtime: " << dtime
                          << " wtime: " << wall_timer.Get();
   return true;
@@ -1526,6 +1528,11 @@ bool BinaryImplicationGraph::ComputeTransitiveReduction(bool log_info) {
   // TODO(user): Can we exploit the fact that the implication graph is a
   // skew-symmetric graph (isomorphic to its transposed) so that we do less
   // work?
+  //
+  // All the descendant traversals below read the contiguous copy of the graph
+  // that we keep in sync with the in-place reduction of implications_. This
+  // matters as the same lists are explored many times from different roots.
+  const int64_t compact_bytes = BuildCompactImplications();
   const LiteralIndex size(implications_.size());
   LiteralIndex previous = kNoLiteralIndex;
   for (const LiteralIndex root : reverse_topological_order_) {
@@ -1575,7 +1582,7 @@ bool BinaryImplicationGraph::ComputeTransitiveReduction(bool log_info) {
         break;
       }
 
-      MarkDescendants(direct_child);
+      MarkDescendantsInternal(direct_child, compact_implications_);
 
       // We have a DAG, so direct_child could only be marked first.
       is_marked_.Clear(direct_child);
@@ -1592,7 +1599,7 @@ bool BinaryImplicationGraph::ComputeTransitiveReduction(bool log_info) {
           if (l.Index() == root) continue;
           if (!is_marked[l.Negated()] && !is_redundant_[l.Negated()]) {
             is_marked_.SetUnsafe(is_marked, l.Negated());
-            MarkDescendants(l.Negated());
+            MarkDescendantsInternal(l.Negated(), compact_implications_);
           }
         }
       }
@@ -1637,6 +1644,7 @@ bool BinaryImplicationGraph::ComputeTransitiveReduction(bool log_info) {
     const int diff = direct_implications.size() - new_size;
     direct_implications.resize(new_size);
     direct_implications.shrink_to_fit();
+    compact_implications_.ReplaceValuesBySmallerSet(root, direct_implications);
     num_new_redundant_implications += diff;
     num_implications_ -= diff;
 
@@ -1648,6 +1656,7 @@ bool BinaryImplicationGraph::ComputeTransitiveReduction(bool log_info) {
   }
 
   is_marked_.ClearAndResize(size);
+  compact_implications_.clear();
 
   // If we aborted early, we might no longer have both a=>b and not(b)=>not(a).
   // This is not desirable has some algo relies on this invariant. We fix this
@@ -1681,7 +1690,8 @@ bool BinaryImplicationGraph::ComputeTransitiveReduction(bool log_info) {
                          << num_new_redundant_implications << " literals. "
                          << num_fixed << " fixed. " << num_implications_
                          << " implications left. " << implications_.size()
-                         << " literals." << " dtime: " << dtime
+                         << " literals." << " compact copy: " << compact_bytes
+                         << " bytes." << " dtime: " << dtime
                          << " wtime: " << wall_timer.Get()
                          << (aborted ? " Aborted." : "");
   return true;
@@ -2366,7 +2376,29 @@ BinaryImplicationGraph::HeuristicAmoPartition(std::vector<Literal>* literals) {
   return result;
 }
 
+int64_t BinaryImplicationGraph::BuildCompactImplications() {
+  int num_entries = 0;
+  for (const auto& list : implications_) num_entries += list.size();
+  compact_implications_.clear();
+  compact_implications_.reserve(implications_.size(), num_entries);
+  for (const auto& list : implications_) {
+    compact_implications_.Add(list);
+  }
+  const int64_t num_bytes =
+      static_cast<int64_t>(num_entries) * sizeof(Literal) +
+      static_cast<int64_t>(implications_.size()) * 2 * sizeof(int);
+  max_compact_implications_bytes_ =
+      std::max(max_compact_implications_bytes_, num_bytes);
+  return num_bytes;
+}
+
 void BinaryImplicationGraph::MarkDescendants(Literal root) {
+  MarkDescendantsInternal(root, implications_);
+}
+
+template <typename ImplicationGraph>
+void BinaryImplicationGraph::MarkDescendantsInternal(
+    Literal root, const ImplicationGraph& graph) {
   auto* const stack = bfs_stack_.data();
   auto is_marked = is_marked_.BitsetView();
   auto is_redundant = is_redundant_.const_view();
@@ -2381,8 +2413,8 @@ void BinaryImplicationGraph::MarkDescendants(Literal root) {
     const Literal current = stack[j];
     if (!implies_something[current]) continue;
 
-    work_done_in_mark_descendants_ += implications_[current].size();
-    for (const Literal l : implications_[current]) {
+    work_done_in_mark_descendants_ += graph[current].size();
+    for (const Literal l : graph[current]) {
       if (!is_marked[l] && !is_redundant[l]) {
         is_marked_.SetUnsafe(is_marked, l);
         stack[stack_size++] = l;
@@ -14,13 +14,16 @@
 #include "ortools/sat/clause.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <numeric>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
 #include "absl/random/random.h"
 #include "absl/types/span.h"
+#include "benchmark/benchmark.h"
 #include "gtest/gtest.h"
 #include "ortools/base/gmock.h"
 #include "ortools/sat/model.h"
@@ -222,6 +225,22 @@ TEST(BinaryImplicationGraphTest, BasicRandomTransitiveReduction) {
   EXPECT_LT(graph->num_implications(), num_added);
 }
 
+TEST(BinaryImplicationGraphTest, CompactImplicationsBytes) {
+  Model model;
+  model.GetOrCreate<SatSolver>()->SetNumVariables(10);
+  auto* graph = model.GetOrCreate<BinaryImplicationGraph>();
+  EXPECT_EQ(graph->max_compact_implications_bytes(), 0);
+
+  for (BooleanVariable i(0); i + 1 < 10; ++i) {
+    graph->AddImplication(Literal(i, true), Literal(i + 1, true));
+  }
+  EXPECT_TRUE(graph->ComputeTransitiveReduction());
+
+  // One Literal per implication, and a start and a size per literal.
+  EXPECT_EQ(graph->max_compact_implications_bytes(),
+            2 * 9 * sizeof(Literal) + 2 * 10 * 2 * sizeof(int));
+}
+
 // We generate a random 2-SAT problem, and check that the propagation is
 // unchanged whether or not the graph is reduced.
 TEST(BinaryImplicationGraph, RandomTransitiveReduction) {
@@ -421,6 +440,41 @@ TEST(BinaryImplicationGraphTest, RandomImpliedLiteral) {
   EXPECT_THAT(seen, UnorderedLiteralsAre(-2, -4, -5, +6, +7));
 }
 
+// Reports the extra memory used by the compact copy of the implications next
+// to the one of the propagation lists, and the time of the passes using it.
+static void BM_DetectEquivalencesAndTransitiveReduction(
+    benchmark::State& state) {
+  const int num_vars = state.range(0);
+  int64_t implication_bytes = 0;
+  int64_t compact_bytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    Model model;
+    model.GetOrCreate<SatSolver>()->SetNumVariables(num_vars);
+    auto* graph = model.GetOrCreate<BinaryImplicationGraph>();
+    absl::BitGen random;
+    for (int i = 0; i < 4 * num_vars; ++i) {
+      const BooleanVariable a(absl::Uniform<int>(random, 0, num_vars));
+      const BooleanVariable b(absl::Uniform<int>(random, 0, num_vars));
+      if (a == b) continue;
+      graph->AddImplication(Literal(a, absl::Bernoulli(random, 0.5)),
+                            Literal(b, absl::Bernoulli(random, 0.5)));
+    }
+    implication_bytes = graph->num_implications() * sizeof(Literal);
+    state.ResumeTiming();
+
+    CHECK(graph->DetectEquivalences());
+    CHECK(graph->ComputeTransitiveReduction());
+    compact_bytes = graph->max_compact_implications_bytes();
+  }
+  state.counters["implication_bytes"] = implication_bytes;
+  state.counters["compact_copy_bytes"] = compact_bytes;
+}
+
+BENCHMARK(BM_DetectEquivalencesAndTransitiveReduction)
+    ->Arg(10'000)
+    ->Arg(100'000);
+
 }  // namespace
 }  // namespace sat
 }  // namespace operations_research
@@ -1097,6 +1097,31 @@ int64_t CompiledIntModConstraint::ComputeViolation(
   }
 }
 
+// ----- CompiledTableConstraint -----
+
+CompiledTableConstraint::CompiledTableConstraint(
+    const ConstraintProto& ct_proto)
+    : CompiledConstraintWithProto(ct_proto) {
+  const TableConstraintProto& table = ct_proto.table();
+  const int num_exprs = table.exprs_size();
+  if (num_exprs == 0) return;
+  for (int i = 0; i + num_exprs <= table.values_size(); i += num_exprs) {
+    const auto begin = table.values().begin() + i;
+    tuples_.insert(std::vector<int64_t>(begin, begin + num_exprs));
+  }
+}
+
+int64_t CompiledTableConstraint::ComputeViolation(
+    absl::Span<const int64_t> solution) {
+  const TableConstraintProto& table = ct_proto().table();
+  if (table.exprs().empty()) return 0;
+  values_.clear();
+  for (const LinearExpressionProto& expr : table.exprs()) {
+    values_.push_back(ExprValue(expr, solution));
+  }
+  return tuples_.contains(values_) == table.negated() ? 1 : 0;
+}
+
 // ----- CompiledAllDiffConstraint -----
 
 CompiledAllDiffConstraint::CompiledAllDiffConstraint(
@@ -1608,6 +1633,10 @@ void LsEvaluator::CompileOneConstraint(const ConstraintProto& ct) {
       constraints_.emplace_back(new CompiledAllDiffConstraint(ct));
       break;
     }
+    case ConstraintProto::ConstraintCase::kTable: {
+      constraints_.emplace_back(new CompiledTableConstraint(ct));
+      break;
+    }
     case ConstraintProto::ConstraintCase::kLinMax: {
       // This constraint is split into linear precedences and its max
       // maintenance.
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/types/span.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/sat_parameters.pb.h"
@@ -521,6 +522,21 @@ class CompiledIntModConstraint : public CompiledConstraintWithProto {
   int64_t ComputeViolation(absl::Span<const int64_t> solution) override;
 };
 
+// The violation of a table constraint is 0 if the values of the expressions
+// form a valid tuple, and 1 otherwise. This is only used for the tables kept
+// by the presolve for the compact table propagator.
+class CompiledTableConstraint : public CompiledConstraintWithProto {
+ public:
+  explicit CompiledTableConstraint(const ConstraintProto& ct_proto);
+  ~CompiledTableConstraint() override = default;
+
+  int64_t ComputeViolation(absl::Span<const int64_t> solution) override;
+
+ private:
+  absl::flat_hash_set<std::vector<int64_t>> tuples_;
+  std::vector<int64_t> values_;
+};
+
 // The violation of a all_diff is the number of unordered pairs of expressions
 // with the same value.
 class CompiledAllDiffConstraint : public CompiledConstraintWithProto {
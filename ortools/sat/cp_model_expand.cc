@@ -1933,6 +1933,19 @@ void ExpandPositiveTable(ConstraintProto* ct, PresolveContext* context) {
     }
   }
 
+  // Large tables are kept as is and will be propagated by the compact table
+  // propagator on top of the full encoding of their variables.
+  if (context->params().use_compact_table_propagator() && num_exprs > 2 &&
+      ct->enforcement_literal().empty()) {
+    TableConstraintProto* mutable_table = ct->mutable_table();
+    mutable_table->clear_values();
+    for (const std::vector<int64_t>& tuple : tuples) {
+      for (const int64_t value : tuple) mutable_table->add_values(value);
+    }
+    context->UpdateRuleStats("table: kept for the compact table propagator");
+    return;
+  }
+
   // Tables with two variables do not need tuple literals.
   //
   // TODO(user): If there is an unique variable with cost, it is better to
@@ -58,6 +58,7 @@
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/symmetry.h"
+#include "ortools/sat/table.h"
 #include "ortools/sat/timetable.h"
 #include "ortools/util/logging.h"
 #include "ortools/util/sorted_interval_list.h"
@@ -1535,6 +1536,62 @@ void LoadAllDiffConstraint(const ConstraintProto& ct, Model* m) {
   m->Add(AllDifferentOnBounds(expressions));
 }
 
+void LoadTableConstraint(const ConstraintProto& ct, Model* m) {
+  // Only the positive tables without enforcement are kept by the expansion.
+  const TableConstraintProto& table = ct.table();
+  CHECK(!table.negated());
+  CHECK(ct.enforcement_literal().empty());
+  const int num_exprs = table.exprs_size();
+  if (num_exprs == 0) return;
+
+  // Map each possible value of each column to the literal encoding it.
+  auto* mapping = m->GetOrCreate<CpModelMapping>();
+  auto* encoder = m->GetOrCreate<IntegerEncoder>();
+  auto* integer_trail = m->GetOrCreate<IntegerTrail>();
+  std::vector<absl::flat_hash_map<int64_t, Literal>> value_to_literal(
+      num_exprs);
+  for (int i = 0; i < num_exprs; ++i) {
+    const AffineExpression expr = mapping->Affine(table.exprs(i));
+    if (integer_trail->IsFixed(expr)) {
+      value_to_literal[i][integer_trail->FixedValue(expr).value()] =
+          encoder->GetTrueLiteral();
+      continue;
+    }
+    encoder->FullyEncodeVariable(expr.var);
+    for (const auto [value, literal] : encoder->FullDomainEncoding(expr.var)) {
+      value_to_literal[i][(expr.coeff * value + expr.constant).value()] =
+          literal;
+    }
+  }
+
+  // Tuples with a value outside the current domains are ignored.
+  std::vector<std::vector<Literal>> literal_tuples;
+  std::vector<absl::flat_hash_set<LiteralIndex>> used_literals(num_exprs);
+  std::vector<Literal> tuple;
+  for (int start = 0; start < table.values_size(); start += num_exprs) {
+    tuple.clear();
+    for (int i = 0; i < num_exprs; ++i) {
+      const auto it = value_to_literal[i].find(table.values(start + i));
+      if (it == value_to_literal[i].end()) break;
+      tuple.push_back(it->second);
+    }
+    if (tuple.size() != num_exprs) continue;
+    for (int i = 0; i < num_exprs; ++i) {
+      used_literals[i].insert(tuple[i].Index());
+    }
+    literal_tuples.push_back(tuple);
+  }
+
+  // The values not appearing in any tuple can be removed right away.
+  for (int i = 0; i < num_exprs; ++i) {
+    for (const auto& [value, literal] : value_to_literal[i]) {
+      if (used_literals[i].contains(literal.Index())) continue;
+      m->Add(ClauseConstraint({literal.Negated()}));
+    }
+  }
+  AddCompactTableConstraint(literal_tuples, m);
+}
+
 void LoadIntProdConstraint(const ConstraintProto& ct, Model* m) {
   auto* mapping = m->GetOrCreate<CpModelMapping>();
   const AffineExpression prod = mapping->Affine(ct.int_prod().target());
@@ -1722,6 +1779,9 @@ bool LoadConstraint(const ConstraintProto& ct, Model* m) {
     case ConstraintProto::ConstraintProto::kAllDiff:
       LoadAllDiffConstraint(ct, m);
       return true;
+    case ConstraintProto::ConstraintProto::kTable:
+      LoadTableConstraint(ct, m);
+      return true;
     case ConstraintProto::ConstraintProto::kIntProd:
       LoadIntProdConstraint(ct, m);
       return true;
@@ -52,6 +52,7 @@
 #include "ortools/base/protobuf_util.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/timer.h"
 #include "ortools/graph/strongly_connected_components.h"
 #include "ortools/graph/topologicalsorter.h"
@@ -5386,7 +5387,11 @@ bool CpModelPresolver::PresolveTable(ConstraintProto* ct) {
   // Convert to the negated table if we gain a lot of entries by doing so.
   // Note however that currently the negated table do not propagate as much as
   // it could.
-  if (static_cast<double>(num_tuples) > 0.7 * prod) {
+  //
+  // The tables still present after expansion are loaded by the compact table
+  // propagator, which only supports positive tables.
+  if (!context_->ModelIsExpanded() &&
+      static_cast<double>(num_tuples) > 0.7 * prod) {
     std::vector<std::vector<int64_t>> current_tuples(num_tuples);
     for (int t = 0; t < num_tuples; ++t) {
       current_tuples[t].resize(num_exprs);
@@ -7692,67 +7697,138 @@ void CpModelPresolver::Probe() {
     }
   });
 
-  prober->ProbeBooleanVariables(
-      context_->params().probing_deterministic_time_limit());
-
-  probing_timer->AddCounter("probed", prober->num_decisions());
-  probing_timer->AddToWork(
-      model.GetOrCreate<TimeLimit>()->GetElapsedDeterministicTime());
-  if (sat_solver->ModelIsUnsat() || !implication_graph->DetectEquivalences()) {
-    return (void)context_->NotifyThatModelIsUnsat("during probing");
-  }
-
-  // Update the presolve context with fixed Boolean variables.
-  int num_fixed = 0;
-  CHECK_EQ(sat_solver->CurrentDecisionLevel(), 0);
-  for (int i = 0; i < sat_solver->LiteralTrail().Index(); ++i) {
-    const Literal l = sat_solver->LiteralTrail()[i];
-    const int var = mapping->GetProtoVariableFromBooleanVariable(l.Variable());
-    if (var >= 0) {
-      const int ref = l.IsPositive() ? var : NegatedRef(var);
-      if (context_->IsFixed(ref)) continue;
-      ++num_fixed;
-      if (!context_->SetLiteralToTrue(ref)) return;
+  // With more than one thread, we load extra copies of the same model (the
+  // Boolean variables are created in the same order) and each copy probes a
+  // disjoint subset of the variables. Only the main copy runs the callback
+  // above since it modifies the working model. All the copies are loaded
+  // before any probing so that they all see the same model.
+  const double probing_limit =
+      context_->params().probing_deterministic_time_limit();
+  const int num_threads = context_->params().num_probing_threads();
+  std::vector<std::unique_ptr<Model>> helper_models;
+  for (int i = 1; i < num_threads; ++i) {
+    Model* helper =
+        helper_models.emplace_back(std::make_unique<Model>()).get();
+
+    // The copies probe concurrently, so each one needs its own random
+    // generator. They are seeded here to keep the probing deterministic.
+    SatParameters helper_params = context_->params();
+    helper_params.set_random_seed(absl::Uniform<int32_t>(
+        *context_->random(), 0, std::numeric_limits<int32_t>::max()));
+    helper->Register<ModelRandomGenerator>(
+        helper->TakeOwnership(new ModelRandomGenerator(helper_params)));
+    if (!LoadModelForProbing(context_, helper)) return;
+  }
+  if (helper_models.empty()) {
+    prober->ProbeBooleanVariables(probing_limit);
+  } else {
+    std::vector<std::vector<BooleanVariable>> bool_vars(num_threads);
+    const int num_bools = sat_solver->NumVariables();
+    int num_unfixed = 0;
+    for (BooleanVariable b(0); b < num_bools; ++b) {
+      if (assignment.VariableIsAssigned(b)) continue;
+      const Literal literal(b, true);
+      if (implication_graph->RepresentativeOf(literal) != literal) continue;
+      bool_vars[num_unfixed++ % num_threads].push_back(b);
+    }
+    {
+      ThreadPool pool("Probing", num_threads - 1);
+      pool.StartWorkers();
+      for (int i = 0; i < helper_models.size(); ++i) {
+        Model* helper = helper_models[i].get();
+        const absl::Span<const BooleanVariable> vars = bool_vars[i + 1];
+        pool.Schedule([helper, vars, probing_limit]() {
+          helper->GetOrCreate<Prober>()->ProbeBooleanVariables(probing_limit,
+                                                               vars);
+        });
+      }
+      prober->ProbeBooleanVariables(probing_limit, bool_vars[0]);
     }
   }
-  probing_timer->AddCounter("fixed_bools", num_fixed);
 
+  // Update the presolve context with everything learned by one model: fixed
+  // Boolean variables, new integer domains and Boolean equivalences. This
+  // returns false if the model was proven infeasible.
+  int num_fixed = 0;
   int num_equiv = 0;
   int num_changed_bounds = 0;
-  const int num_variables = context_->working_model->variables().size();
-  auto* integer_trail = model.GetOrCreate<IntegerTrail>();
-  for (int var = 0; var < num_variables; ++var) {
-    // Restrict IntegerVariable domain.
-    // Note that Boolean are already dealt with above.
-    if (!mapping->IsBoolean(var)) {
-      bool changed = false;
-      if (!context_->IntersectDomainWith(
-              var, integer_trail->InitialVariableDomain(mapping->Integer(var)),
-              &changed)) {
-        return;
+  int64_t num_probed = 0;
+  int64_t num_new_binary_clauses = 0;
+  double max_dtime = 0.0;
+  const auto export_probing_results = [&](Model* local_model) {
+    auto* local_sat_solver = local_model->GetOrCreate<SatSolver>();
+    auto* local_graph = local_model->GetOrCreate<BinaryImplicationGraph>();
+    auto* local_mapping = local_model->GetOrCreate<CpModelMapping>();
+    auto* local_prober = local_model->GetOrCreate<Prober>();
+    num_probed += local_prober->num_decisions();
+    num_new_binary_clauses += local_prober->num_new_binary_clauses();
+    max_dtime = std::max(
+        max_dtime,
+        local_model->GetOrCreate<TimeLimit>()->GetElapsedDeterministicTime());
+    if (local_sat_solver->ModelIsUnsat() ||
+        !local_graph->DetectEquivalences()) {
+      return context_->NotifyThatModelIsUnsat("during probing");
+    }
+
+    CHECK_EQ(local_sat_solver->CurrentDecisionLevel(), 0);
+    for (int i = 0; i < local_sat_solver->LiteralTrail().Index(); ++i) {
+      const Literal l = local_sat_solver->LiteralTrail()[i];
+      const int var =
+          local_mapping->GetProtoVariableFromBooleanVariable(l.Variable());
+      if (var >= 0) {
+        const int ref = l.IsPositive() ? var : NegatedRef(var);
+        if (context_->IsFixed(ref)) continue;
+        ++num_fixed;
+        if (!context_->SetLiteralToTrue(ref)) return false;
       }
-      if (changed) ++num_changed_bounds;
-      continue;
     }
 
-    // Add Boolean equivalence relations.
-    const Literal l = mapping->Literal(var);
-    const Literal r = implication_graph->RepresentativeOf(l);
-    if (r != l) {
-      ++num_equiv;
-      const int r_var =
-          mapping->GetProtoVariableFromBooleanVariable(r.Variable());
-      CHECK_GE(r_var, 0);
-      if (!context_->StoreBooleanEqualityRelation(
-              var, r.IsPositive() ? r_var : NegatedRef(r_var))) {
-        return;
+    const int num_variables = context_->working_model->variables().size();
+    auto* integer_trail = local_model->GetOrCreate<IntegerTrail>();
+    for (int var = 0; var < num_variables; ++var) {
+      // Restrict IntegerVariable domain.
+      // Note that Boolean are already dealt with above.
+      if (!local_mapping->IsBoolean(var)) {
+        bool changed = false;
+        if (!context_->IntersectDomainWith(
+                var,
+                integer_trail->InitialVariableDomain(
+                    local_mapping->Integer(var)),
+                &changed)) {
+          return false;
+        }
+        if (changed) ++num_changed_bounds;
+        continue;
+      }
+
+      // Add Boolean equivalence relations.
+      const Literal l = local_mapping->Literal(var);
+      const Literal r = local_graph->RepresentativeOf(l);
+      if (r != l) {
+        ++num_equiv;
+        const int r_var =
+            local_mapping->GetProtoVariableFromBooleanVariable(r.Variable());
+        CHECK_GE(r_var, 0);
+        if (!context_->StoreBooleanEqualityRelation(
+                var, r.IsPositive() ? r_var : NegatedRef(r_var))) {
+          return false;
+        }
       }
     }
+    return true;
+  };
+  if (!export_probing_results(&model)) return;
+  for (const std::unique_ptr<Model>& helper : helper_models) {
+    if (!export_probing_results(helper.get())) return;
   }
+
+  // The models were probed in parallel, so we only count the longest run.
+  probing_timer->AddToWork(max_dtime);
+  probing_timer->AddCounter("probed", num_probed);
+  probing_timer->AddCounter("fixed_bools", num_fixed);
   probing_timer->AddCounter("new_bounds", num_changed_bounds);
   probing_timer->AddCounter("equiv", num_equiv);
-  probing_timer->AddCounter("new_binary_clauses",
-                            prober->num_new_binary_clauses());
+  probing_timer->AddCounter("new_binary_clauses", num_new_binary_clauses);
 
   // Note that we prefer to run this after we exported all equivalence to the
   // context, so that our enforcement list can be presolved to the best of our
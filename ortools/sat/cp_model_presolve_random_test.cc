@@ -217,6 +217,22 @@ TEST_P(RandomPreprocessorTest, SolveWithAndWithoutPresolve) {
               response_without.objective_value(), 1e-9);
 }
 
+TEST_P(RandomPreprocessorTest, SolveWithParallelProbing) {
+  const CpModelProto model_proto = GenerateRandomProblem(GetSeedEnvName());
+
+  SatParameters params;
+  params.set_cp_model_presolve(true);
+  params.set_num_probing_threads(3);
+  const CpSolverResponse response_with =
+      SolveWithParameters(model_proto, params);
+  params.set_cp_model_presolve(false);
+  const CpSolverResponse response_without =
+      SolveWithParameters(model_proto, params);
+  EXPECT_EQ(response_with.status(), response_without.status());
+  EXPECT_NEAR(response_with.objective_value(),
+              response_without.objective_value(), 1e-9);
+}
+
 // Note that because we just generate linear model, this doesn't exercise all
 // the expansion code which is likely to lose the hint. Still it is a start.
 TEST_P(RandomPreprocessorTest, TestHintSurvivePresolve) {
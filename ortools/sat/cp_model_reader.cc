@@ -0,0 +1,126 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/cp_model_reader.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/message_lite.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "ortools/sat/cp_model.pb.h"
+
+namespace operations_research {
+namespace sat {
+
+namespace {
+
+using ::google::protobuf::internal::WireFormatLite;
+using ::google::protobuf::io::CodedInputStream;
+
+// A CodedInputStream cannot read more than 2GB, so we use a new one each time
+// this many bytes were read.
+constexpr int kMaxBytesPerCodedStream = 1 << 30;
+
+// Reads a length-delimited sub-message.
+bool ReadMessage(CodedInputStream* input,
+                 google::protobuf::MessageLite* message) {
+  uint32_t length;
+  if (!input->ReadVarint32(&length)) return false;
+  const CodedInputStream::Limit limit = input->PushLimit(length);
+  if (!message->MergePartialFromCodedStream(input) ||
+      !input->ConsumedEntireMessage()) {
+    return false;
+  }
+  input->PopLimit(limit);
+  return true;
+}
+
+}  // namespace
+
+absl::Status ReadCpModelProtoFromStream(
+    google::protobuf::io::ZeroCopyInputStream* stream, CpModelProto* model) {
+  model->Clear();
+
+  // The other fields are a lot smaller than the variables and constraints. We
+  // just copy them in the wire format and parse them at the end.
+  std::string other_fields;
+  bool constraints_started = false;
+  bool done = false;
+  while (!done) {
+    CodedInputStream input(stream);
+    while (input.CurrentPosition() < kMaxBytesPerCodedStream) {
+      const uint32_t tag = input.ReadTag();
+      if (tag == 0) {
+        if (!input.ConsumedEntireMessage()) {
+          return absl::InvalidArgumentError("Invalid tag in CpModelProto.");
+        }
+        done = true;
+        break;
+      }
+
+      const int field = WireFormatLite::GetTagFieldNumber(tag);
+      const bool is_message = WireFormatLite::GetTagWireType(tag) ==
+                              WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+      if (is_message && field == CpModelProto::kVariablesFieldNumber) {
+        if (constraints_started) {
+          return absl::InvalidArgumentError(
+              "The variables must appear before the constraints.");
+        }
+        if (!ReadMessage(&input, model->add_variables())) {
+          return absl::InvalidArgumentError(absl::StrCat(
+              "Cannot parse variable #", model->variables_size() - 1));
+        }
+      } else if (is_message && field == CpModelProto::kConstraintsFieldNumber) {
+        constraints_started = true;
+        if (!ReadMessage(&input, model->add_constraints())) {
+          return absl::InvalidArgumentError(absl::StrCat(
+              "Cannot parse constraint #", model->constraints_size() - 1));
+        }
+      } else {
+        google::protobuf::io::StringOutputStream string_stream(&other_fields);
+        google::protobuf::io::CodedOutputStream output(&string_stream);
+        if (!WireFormatLite::SkipField(&input, tag, &output)) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Cannot parse field #", field, " of CpModelProto."));
+        }
+      }
+    }
+  }
+
+  if (!other_fields.empty() && !model->MergeFromString(other_fields)) {
+    return absl::InvalidArgumentError("Cannot parse CpModelProto.");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ReadCpModelProtoFromBinaryFile(absl::string_view filename,
+                                            CpModelProto* model) {
+  std::ifstream file(std::string(filename), std::ios::binary);
+  if (!file) {
+    return absl::NotFoundError(absl::StrCat("Cannot open '", filename, "'."));
+  }
+  google::protobuf::io::IstreamInputStream stream(&file);
+  return ReadCpModelProtoFromStream(&stream, model);
+}
+
+}  // namespace sat
+}  // namespace operations_research
@@ -0,0 +1,46 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_SAT_CP_MODEL_READER_H_
+#define OR_TOOLS_SAT_CP_MODEL_READER_H_
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+#include "ortools/sat/cp_model.pb.h"
+
+namespace operations_research {
+namespace sat {
+
+// Reads a CpModelProto in the binary wire format from the given stream,
+// directly into the given model which is cleared first.
+//
+// Unlike ParseFromString(), this reads the variables and constraints one at a
+// time, so the serialized model never needs to be fully in memory, and it
+// works for models larger than 2GB. Like ParseFromString(), this only checks
+// the wire format: the model must still go through ValidateCpModel().
+//
+// The variables must appear before the constraints in the stream, which is
+// the case with all the protobuf serializers. On error, the content of model
+// is unspecified.
+absl::Status ReadCpModelProtoFromStream(
+    google::protobuf::io::ZeroCopyInputStream* stream, CpModelProto* model);
+
+// Same as ReadCpModelProtoFromStream() for a binary file.
+absl::Status ReadCpModelProtoFromBinaryFile(absl::string_view filename,
+                                            CpModelProto* model);
+
+}  // namespace sat
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_SAT_CP_MODEL_READER_H_
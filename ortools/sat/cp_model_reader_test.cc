@@ -0,0 +1,99 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/cp_model_reader.h"
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/parse_test_proto.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_checker.h"
+
+namespace operations_research {
+namespace sat {
+namespace {
+
+using ::google::protobuf::contrib::parse_proto::ParseTestProto;
+using ::testing::EqualsProto;
+
+TEST(ReadCpModelProtoFromStreamTest, SameAsParsing) {
+  const CpModelProto model_proto = ParseTestProto(R"pb(
+    name: "test"
+    variables { domain: [ 0, 10 ] }
+    variables { domain: [ 0, 1 ] }
+    variables { domain: [ 0, 5 ] }
+    constraints {
+      enforcement_literal: 1
+      linear {
+        vars: [ 0, 2 ]
+        coeffs: [ 1, 2 ]
+        domain: [ 0, 8 ]
+      }
+    }
+    constraints { bool_or { literals: [ 1 ] } }
+    objective {
+      vars: [ 0, 2 ]
+      coeffs: [ 1, -1 ]
+    }
+    solution_hint {
+      vars: [ 0 ]
+      values: [ 3 ]
+    }
+  )pb");
+  const std::string data = model_proto.SerializeAsString();
+
+  // Use a small block size to read the variables across block boundaries.
+  google::protobuf::io::ArrayInputStream stream(data.data(), data.size(),
+                                                /*block_size=*/3);
+  CpModelProto read_proto;
+  ASSERT_TRUE(ReadCpModelProtoFromStream(&stream, &read_proto).ok());
+  EXPECT_THAT(read_proto, EqualsProto(model_proto));
+}
+
+TEST(ReadCpModelProtoFromStreamTest, InvalidConstraintIsLeftToTheValidation) {
+  const CpModelProto model_proto = ParseTestProto(R"pb(
+    variables { domain: [ 0, 10 ] }
+    constraints {
+      linear {
+        vars: [ 3 ]
+        coeffs: [ 1 ]
+        domain: [ 0, 8 ]
+      }
+    }
+  )pb");
+  const std::string data = model_proto.SerializeAsString();
+  google::protobuf::io::ArrayInputStream stream(data.data(), data.size());
+  CpModelProto read_proto;
+  ASSERT_TRUE(ReadCpModelProtoFromStream(&stream, &read_proto).ok());
+  EXPECT_THAT(read_proto, EqualsProto(model_proto));
+  EXPECT_FALSE(ValidateCpModel(read_proto).empty());
+}
+
+TEST(ReadCpModelProtoFromStreamTest, TruncatedStream) {
+  const CpModelProto model_proto = ParseTestProto(R"pb(
+    variables { domain: [ 0, 10 ] }
+    variables { domain: [ 0, 10 ] }
+  )pb");
+  const std::string data = model_proto.SerializeAsString();
+  google::protobuf::io::ArrayInputStream stream(data.data(), data.size() - 1);
+  CpModelProto read_proto;
+  EXPECT_FALSE(ReadCpModelProtoFromStream(&stream, &read_proto).ok());
+}
+
+}  // namespace
+}  // namespace sat
+}  // namespace operations_research
@@ -82,6 +82,8 @@
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/shaving_solver.h"
+#include "ortools/sat/solve_telemetry.h"
+#include "ortools/sat/solve_telemetry.pb.h"
 #include "ortools/sat/stat_tables.h"
 #include "ortools/sat/subsolver.h"
 #include "ortools/sat/synchronization.h"
@@ -839,6 +841,14 @@ void LaunchSubsolvers(const SatParameters& params, SharedClasses* shared,
   }
   LogSubsolverNames(subsolvers, ignored, shared->logger);
 
+  // This is added after the logging, since it is just a helper.
+  if (shared->telemetry != nullptr) {
+    subsolvers.push_back(std::make_unique<SynchronizationPoint>(
+        "telemetry", [shared, &subsolvers]() {
+          shared->telemetry->UpdateSubsolvers(subsolvers);
+        }));
+  }
+
   // Launch the main search loop.
   if (params.interleave_search()) {
     int batch_size = params.interleave_batch_size();
@@ -858,9 +868,13 @@ void LaunchSubsolvers(const SatParameters& params, SharedClasses* shared,
   // We need to delete the subsolvers in order to fill the stat tables. Note
   // that first solution should already be deleted. We delete manually as
   // windows release vectors in the opposite order.
+  if (shared->telemetry != nullptr) {
+    shared->telemetry->UpdateSubsolvers(subsolvers);
+  }
   for (int i = 0; i < subsolvers.size(); ++i) {
     subsolvers[i].reset();
   }
+  if (shared->telemetry != nullptr) shared->telemetry->ReportFinal();
   LogFinalStatistics(shared);
 }
 
@@ -1069,6 +1083,14 @@ class FullProblemSolver : public SubSolver {
     shared_->stat_tables->AddLpStat(name(), &local_model_);
     shared_->stat_tables->AddSearchStat(name(), &local_model_);
     shared_->stat_tables->AddClausesStat(name(), &local_model_);
+
+    // Export the last statistics, if the model was loaded.
+    if (shared_->telemetry != nullptr && !solving_first_chunk_) {
+      WorkerTelemetry worker;
+      worker.set_name(name());
+      FillWorkerSearchTelemetry(&local_model_, &worker);
+      shared_->telemetry->UpdateWorker(worker);
+    }
   }
 
   bool IsDone() override {
@@ -1128,6 +1150,11 @@ class FullProblemSolver : public SubSolver {
           RegisterClausesExport(id, shared_->clauses.get(), &local_model_);
         }
 
+        if (shared_->telemetry != nullptr) {
+          RegisterWorkerTelemetryExport(name(), shared_->telemetry,
+                                        &local_model_);
+        }
+
         auto* logger = local_model_.GetOrCreate<SolverLogger>();
         SOLVER_LOG(logger, "");
         SOLVER_LOG(logger, absl::StrFormat(
@@ -1717,6 +1744,15 @@ class LnsSolver : public SubSolver {
     const double dtime = generator_->Synchronize();
     AddTaskDeterministicDuration(dtime);
     shared_->time_limit->AdvanceDeterministicTime(dtime);
+    if (shared_->telemetry != nullptr && dtime > 0.0) {
+      WorkerTelemetry worker;
+      worker.set_name(name());
+      worker.set_num_lns_calls(generator_->num_calls());
+      worker.set_num_lns_fully_solved_calls(
+          generator_->num_fully_solved_calls());
+      worker.set_num_lns_improving_calls(generator_->num_improving_calls());
+      shared_->telemetry->UpdateWorker(worker);
+    }
   }
 
  private:
@@ -1777,6 +1813,9 @@ void SolveCpModelParallel(SharedClasses* shared, Model* global_model) {
         if (shared->clauses != nullptr) {
           shared->clauses->Synchronize();
         }
+        if (shared->state_exchanger != nullptr) {
+          shared->state_exchanger->Synchronize();
+        }
       }));
 
   const auto name_to_params = GetNamedParameters(params);
@@ -2229,6 +2268,13 @@ std::function<void(Model*)> NewBestBoundCallback(
   };
 }
 
+std::function<void(Model*)> NewSolveTelemetryCallback(
+    const std::function<void(const SolveTelemetry&)>& callback) {
+  return [callback = callback](Model* model) {
+    model->GetOrCreate<SharedTelemetry>()->AddCallback(callback);
+  };
+}
+
 #if !defined(__PORTABLE_PLATFORM__)
 // TODO(user): Support it on android.
 std::function<SatParameters(Model*)> NewSatParameters(
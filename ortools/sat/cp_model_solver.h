@@ -21,6 +21,7 @@
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/sat/solve_telemetry.pb.h"
 
 ABSL_DECLARE_FLAG(bool, cp_model_dump_response);
 
@@ -114,6 +115,19 @@ std::function<void(Model*)> NewFeasibleSolutionLogCallback(
 std::function<void(Model*)> NewBestBoundCallback(
     const std::function<void(double)>& callback);
 
+/**
+ * Creates a callback that will be called periodically during the search with
+ * machine readable statistics on each worker: search counters and rates, LP
+ * iterations, LNS success, and time spent in each type of propagator and cut
+ * generator. The period is given by the telemetry_period_in_seconds parameter,
+ * and a last report is sent when the search is done.
+ *
+ * The per-worker statistics are only collected when such a callback is
+ * registered. The callback is called while holding a mutex and should be fast.
+ */
+std::function<void(Model*)> NewSolveTelemetryCallback(
+    const std::function<void(const SolveTelemetry&)>& callback);
+
 /**
  * Creates parameters for the solver, which you can add to the model with
  * \code
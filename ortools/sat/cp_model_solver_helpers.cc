@@ -74,6 +74,8 @@
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
+#include "ortools/sat/shared_state_exchange.h"
+#include "ortools/sat/solve_telemetry.h"
 #include "ortools/sat/stat_tables.h"
 #include "ortools/sat/symmetry_util.h"
 #include "ortools/sat/synchronization.h"
@@ -1130,7 +1132,9 @@ void LoadBaseModel(const CpModelProto& model_proto, Model* model) {
   model->GetOrCreate<PrecedenceRelations>()->Resize(
       model->GetOrCreate<IntegerTrail>()->NumIntegerVariables().value());
 
-  // Load the constraints.
+  // Load the constraints. The propagators are tagged with the constraint type
+  // for the statistics.
+  auto* watcher = model->GetOrCreate<GenericLiteralWatcher>();
   int num_ignored_constraints = 0;
   absl::flat_hash_set<ConstraintProto::ConstraintCase> unsupported_types;
   for (const ConstraintProto& ct : model_proto.constraints()) {
@@ -1139,6 +1143,7 @@ void LoadBaseModel(const CpModelProto& model_proto, Model* model) {
       continue;
     }
 
+    watcher->SetRegistrationTag(ConstraintCaseName(ct.constraint_case()));
     if (!LoadConstraint(ct, model)) {
       unsupported_types.insert(ct.constraint_case());
       continue;
@@ -1166,6 +1171,7 @@ void LoadBaseModel(const CpModelProto& model_proto, Model* model) {
       return unsat();
     }
   }
+  watcher->SetRegistrationTag("");
   if (num_ignored_constraints > 0) {
     VLOG(3) << num_ignored_constraints << " constraints were skipped.";
   }
@@ -1319,8 +1325,11 @@ void LoadCpModel(const CpModelProto& model_proto, Model* model) {
   IntegerVariable objective_var = kNoIntegerVariable;
   if (parameters.linearization_level() > 0) {
     // Linearize some part of the problem and register LP constraint(s).
+    auto* watcher = model->GetOrCreate<GenericLiteralWatcher>();
+    watcher->SetRegistrationTag("lp");
     objective_var =
         AddLPConstraints(objective_need_to_be_tight, model_proto, model);
+    watcher->SetRegistrationTag("");
     if (sat_solver->ModelIsUnsat()) return unsat();
   } else if (model_proto.has_objective()) {
     const CpObjectiveProto& obj = model_proto.objective();
@@ -2013,6 +2022,24 @@ SharedClasses::SharedClasses(const CpModelProto* proto, Model* global_model)
     clauses = std::make_unique<SharedClausesManager>(always_synchronize,
                                                      absl::Seconds(1));
   }
+  if (params.share_lb_tree_search_nodes() && params.num_workers() > 1) {
+    lb_tree_search_nodes = std::make_unique<SharedLbTreeSearchNodes>();
+  }
+
+  // Share our progress with the other processes of a distributed solve.
+  if (auto* transport = global_model->Mutable<SharedStateTransport>();
+      transport != nullptr) {
+    state_exchanger = std::make_unique<SharedStateExchanger>(
+        params.name(), *proto, transport, response, bounds.get(),
+        clauses.get());
+  }
+
+  if (auto* shared_telemetry = global_model->Mutable<SharedTelemetry>();
+      shared_telemetry != nullptr && shared_telemetry->HasCallbacks()) {
+    telemetry = shared_telemetry;
+    telemetry->Start(params.telemetry_period_in_seconds(), wall_timer,
+                     time_limit);
+  }
 }
 
 void SharedClasses::RegisterSharedClassesInLocalModel(Model* local_model) {
@@ -2038,6 +2065,9 @@ void SharedClasses::RegisterSharedClassesInLocalModel(Model* local_model) {
   if (clauses != nullptr) {
     local_model->Register<SharedClausesManager>(clauses.get());
   }
+  if (lb_tree_search_nodes != nullptr) {
+    local_model->Register<SharedLbTreeSearchNodes>(lb_tree_search_nodes.get());
+  }
 }
 
 bool SharedClasses::SearchIsDone() {
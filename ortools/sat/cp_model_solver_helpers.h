@@ -28,6 +28,8 @@
 #include "ortools/sat/integer_base.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/sat/shared_state_exchange.h"
+#include "ortools/sat/solve_telemetry.h"
 #include "ortools/sat/stat_tables.h"
 #include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
@@ -68,6 +70,15 @@ struct SharedClasses {
   std::unique_ptr<SharedLPSolutionRepository> lp_solutions;
   std::unique_ptr<SharedIncompleteSolutionManager> incomplete_solutions;
   std::unique_ptr<SharedClausesManager> clauses;
+  std::unique_ptr<SharedLbTreeSearchNodes> lb_tree_search_nodes;
+
+  // Only created if a SharedStateTransport was registered in the global model,
+  // in which case this process is part of a distributed solve.
+  std::unique_ptr<SharedStateExchanger> state_exchanger;
+
+  // Owned by the global model. Only set if a callback was registered with
+  // NewSolveTelemetryCallback().
+  SharedTelemetry* telemetry = nullptr;
 
   // call local_model->Register() on most of the class here, this allow to
   // more easily depends on one of the shared class deep within the solver.
@@ -20,6 +20,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <functional>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -53,10 +54,26 @@ namespace sat {
 // - Only look at the lp_values positions that corresponds to its 'vars' or
 //   their negation.
 // - Only add cuts in term of the same variables or their negation.
+//
+// If can_run_concurrently is true, generate_cuts() might be called at the
+// same time as the one of other generators. It must then only read the LP
+// values and the solver state (no modification, no shared random generator,
+// no time limit update) and only call AddCut() on the given manager.
 struct CutGenerator {
+  // Only used in the statistics. By default, this is the type of the
+  // constraint that created this generator.
+  std::string name;
   bool only_run_at_level_zero = false;
+  bool can_run_concurrently = false;
   std::vector<IntegerVariable> vars;
   absl::AnyInvocable<bool(LinearConstraintManager* manager)> generate_cuts;
+
+  // Only used if can_run_concurrently is true. If set, this is called on the
+  // main thread before each generate_cuts() call. The seed is drawn from the
+  // model random generator when the call will run on a cut generation thread,
+  // and is std::nullopt when it will run on the main thread, in which case the
+  // model random generator can be used directly.
+  absl::AnyInvocable<void(std::optional<uint64_t> seed)> set_random_seed;
 };
 
 // To simplify cut generation code, we use a more complex data structure than
@@ -876,6 +876,7 @@ bool RectanglePairwisePropagator::Propagate() {
 
   num_calls_++;
   std::vector<PairwiseRestriction> restrictions;
+  pair_budget_ = params_->max_pairs_pairwise_reasoning_in_no_overlap_2d();
 
   for (int component_index = 0;
        component_index < helper_->connected_components().size();
@@ -946,12 +947,7 @@ bool RectanglePairwisePropagator::Propagate() {
 bool RectanglePairwisePropagator::FindRestrictionsAndPropagateConflict(
     absl::Span<const ItemWithVariableSize> items,
     std::vector<PairwiseRestriction>* restrictions) {
-  const int max_pairs =
-      params_->max_pairs_pairwise_reasoning_in_no_overlap_2d();
-  if (items.size() * (items.size() - 1) / 2 > max_pairs) {
-    return true;
-  }
-  AppendPairwiseRestrictions(items, restrictions);
+  AppendPairwiseRestrictions(items, restrictions, &pair_budget_);
   for (const PairwiseRestriction& restriction : *restrictions) {
     if (restriction.type ==
         PairwiseRestriction::PairwiseRestrictionType::CONFLICT) {
@@ -965,12 +961,7 @@ bool RectanglePairwisePropagator::FindRestrictionsAndPropagateConflict(
     absl::Span<const ItemWithVariableSize> items1,
     absl::Span<const ItemWithVariableSize> items2,
     std::vector<PairwiseRestriction>* restrictions) {
-  const int max_pairs =
-      params_->max_pairs_pairwise_reasoning_in_no_overlap_2d();
-  if (items1.size() * items2.size() > max_pairs) {
-    return true;
-  }
-  AppendPairwiseRestrictions(items1, items2, restrictions);
+  AppendPairwiseRestrictions(items1, items2, restrictions, &pair_budget_);
   for (const PairwiseRestriction& restriction : *restrictions) {
     if (restriction.type ==
         PairwiseRestriction::PairwiseRestrictionType::CONFLICT) {
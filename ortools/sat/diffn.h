@@ -186,6 +186,10 @@ class RectanglePairwisePropagator : public PropagatorInterface {
   int64_t num_pairwise_conflicts_ = 0;
   int64_t num_pairwise_propagations_ = 0;
 
+  // The number of pairs that can still be looked at in the current call to
+  // Propagate(), see max_pairs_pairwise_reasoning_in_no_overlap_2d.
+  int64_t pair_budget_ = 0;
+
   std::vector<Rectangle> fixed_non_zero_area_rectangles_;
   std::vector<ItemWithVariableSize> fixed_non_zero_area_boxes_;
   std::vector<ItemWithVariableSize> non_fixed_non_zero_area_boxes_;
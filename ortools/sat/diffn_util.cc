@@ -579,6 +579,7 @@ std::vector<int> GetIntervalArticulationPoints(
 
 namespace {
 bool IsZeroOrPowerOfTwo(int value) { return (value & (value - 1)) == 0; }
+}  // namespace
 
 void AppendPairwiseRestriction(const ItemWithVariableSize& item1,
                                const ItemWithVariableSize& item2,
@@ -647,26 +648,88 @@ void AppendPairwiseRestriction(const ItemWithVariableSize& item1,
       break;
   }
 }
-}  // namespace
 
-void AppendPairwiseRestrictions(absl::Span<const ItemWithVariableSize> items,
-                                std::vector<PairwiseRestriction>* result) {
-  for (int i1 = 0; i1 + 1 < items.size(); ++i1) {
-    for (int i2 = i1 + 1; i2 < items.size(); ++i2) {
-      AppendPairwiseRestriction(items[i1], items[i2], result);
+namespace {
+// Appends the restrictions between the items of `items` and the ones of
+// `other_items`, or between all the pairs of `items` if other_items is empty.
+//
+// If the ranges [start_min, end_max) of two items do not overlap on one axis,
+// one of them can always be placed before the other on this axis, without any
+// possible push. So AppendPairwiseRestriction() does nothing, and we only need
+// to look at the pairs overlapping on both axis. We sweep the items by
+// increasing x.start_min and only keep "active" the items whose x.end_max is
+// after the sweep line.
+bool SweepPairwiseRestrictions(
+    absl::Span<const ItemWithVariableSize> items,
+    absl::Span<const ItemWithVariableSize> other_items,
+    std::vector<PairwiseRestriction>* result, int64_t* pair_budget) {
+  const bool single_set = other_items.empty();
+  const auto get_item = [&](int set, int index) -> decltype(auto) {
+    return set == 0 ? items[index] : other_items[index];
+  };
+
+  // Events are (set, index in set), sorted by x.start_min. Ties are broken by
+  // set and index to be deterministic.
+  std::vector<std::pair<int, int>> events;
+  events.reserve(items.size() + other_items.size());
+  for (int i = 0; i < items.size(); ++i) events.push_back({0, i});
+  for (int i = 0; i < other_items.size(); ++i) events.push_back({1, i});
+  std::sort(events.begin(), events.end(),
+            [&](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+              const IntegerValue a_start =
+                  get_item(a.first, a.second).x.start_min;
+              const IntegerValue b_start =
+                  get_item(b.first, b.second).x.start_min;
+              if (a_start != b_start) return a_start < b_start;
+              return a < b;
+            });
+
+  std::vector<int> active[2];
+  for (const auto [set, index] : events) {
+    const ItemWithVariableSize& item = get_item(set, index);
+    const int other_set = single_set ? 0 : 1 - set;
+
+    // Scan the active items of the other set, and remove the ones that end
+    // before the sweep line, they will not overlap any of the next items.
+    std::vector<int>& other_active = active[other_set];
+    int new_size = 0;
+    for (const int other_index : other_active) {
+      const ItemWithVariableSize& other = get_item(other_set, other_index);
+      if (other.x.end_max <= item.x.start_min) continue;
+      other_active[new_size++] = other_index;
+      if (pair_budget != nullptr) {
+        if (*pair_budget == 0) return false;
+        --*pair_budget;
+      }
+      if (item.x.end_max <= other.x.start_min) continue;
+      if (item.y.end_max <= other.y.start_min) continue;
+      if (other.y.end_max <= item.y.start_min) continue;
+      // The items of `items` are always first.
+      if (set == 0 && !single_set) {
+        AppendPairwiseRestriction(item, other, result);
+      } else {
+        AppendPairwiseRestriction(other, item, result);
+      }
     }
+    other_active.resize(new_size);
+    active[set].push_back(index);
   }
+  return true;
 }
+}  // namespace
 
-void AppendPairwiseRestrictions(
+bool AppendPairwiseRestrictions(absl::Span<const ItemWithVariableSize> items,
+                                std::vector<PairwiseRestriction>* result,
+                                int64_t* pair_budget) {
+  return SweepPairwiseRestrictions(items, {}, result, pair_budget);
+}
+
+bool AppendPairwiseRestrictions(
     absl::Span<const ItemWithVariableSize> items,
     absl::Span<const ItemWithVariableSize> other_items,
-    std::vector<PairwiseRestriction>* result) {
-  for (int i1 = 0; i1 < items.size(); ++i1) {
-    for (int i2 = 0; i2 < other_items.size(); ++i2) {
-      AppendPairwiseRestriction(items[i1], other_items[i2], result);
-    }
-  }
+    std::vector<PairwiseRestriction>* result, int64_t* pair_budget) {
+  if (other_items.empty()) return true;
+  return SweepPairwiseRestrictions(items, other_items, result, pair_budget);
 }
 
 void CapacityProfile::Clear() {
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <optional>
@@ -307,17 +308,32 @@ struct PairwiseRestriction {
   }
 };
 
+// Appends the restriction between item1 and item2 to `result`, if they are
+// either in conflict or one could have its range shrinked to avoid a conflict.
+void AppendPairwiseRestriction(const ItemWithVariableSize& item1,
+                               const ItemWithVariableSize& item2,
+                               std::vector<PairwiseRestriction>* result);
+
 // Find pair of items that are either in conflict or could have their range
 // shrinked to avoid conflict.
-void AppendPairwiseRestrictions(absl::Span<const ItemWithVariableSize> items,
-                                std::vector<PairwiseRestriction>* result);
+//
+// Only the pairs of items whose ranges [start_min, end_max) overlap on both
+// axis can lead to a restriction. These are found with a sweep line on x, so
+// the complexity is O(n log n) plus the number of pairs overlapping on x.
+// If `pair_budget` is not null, each such pair looked at decrements it, and
+// this stops early and returns false once it reaches zero. This allows to share
+// a budget between several calls. The restrictions found so far are still
+// valid.
+bool AppendPairwiseRestrictions(absl::Span<const ItemWithVariableSize> items,
+                                std::vector<PairwiseRestriction>* result,
+                                int64_t* pair_budget = nullptr);
 
 // Same as above, but test `items` against `other_items` and append the
 // restrictions found to `result`.
-void AppendPairwiseRestrictions(
+bool AppendPairwiseRestrictions(
     absl::Span<const ItemWithVariableSize> items,
     absl::Span<const ItemWithVariableSize> other_items,
-    std::vector<PairwiseRestriction>* result);
+    std::vector<PairwiseRestriction>* result, int64_t* pair_budget = nullptr);
 
 // This class is used by the no_overlap_2d constraint to maintain the envelope
 // of a set of rectangles. This envelope is not the convex hull, but the exact
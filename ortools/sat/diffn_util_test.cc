@@ -1185,6 +1185,108 @@ TEST(FindPairwiseRestrictionsTest, Random) {
   }
 }
 
+ItemWithVariableSize::Interval RandomItemInterval(absl::BitGenRef random) {
+  const IntegerValue start_min(absl::Uniform(random, 0, 20));
+  const IntegerValue slack(absl::Uniform(random, 0, 5));
+  const IntegerValue size(absl::Uniform(random, 0, 5));
+  return {.start_min = start_min,
+          .start_max = start_min + slack,
+          .end_min = start_min + size,
+          .end_max = start_min + slack + size};
+}
+
+// Returns the same restriction with its two items swapped.
+PairwiseRestriction Mirror(const PairwiseRestriction& restriction) {
+  using Type = PairwiseRestriction::PairwiseRestrictionType;
+  Type type = restriction.type;
+  switch (type) {
+    case Type::CONFLICT:
+      break;
+    case Type::FIRST_BELOW_SECOND:
+      type = Type::FIRST_ABOVE_SECOND;
+      break;
+    case Type::FIRST_ABOVE_SECOND:
+      type = Type::FIRST_BELOW_SECOND;
+      break;
+    case Type::FIRST_LEFT_OF_SECOND:
+      type = Type::FIRST_RIGHT_OF_SECOND;
+      break;
+    case Type::FIRST_RIGHT_OF_SECOND:
+      type = Type::FIRST_LEFT_OF_SECOND;
+      break;
+  }
+  return {.first_index = restriction.second_index,
+          .second_index = restriction.first_index,
+          .type = type};
+}
+
+TEST(FindPairwiseRestrictionsTest, SameAsLookingAtAllPairs) {
+  absl::BitGen random;
+  constexpr int num_runs = 200;
+  for (int k = 0; k < num_runs; k++) {
+    const int num_items = absl::Uniform(random, 1, 30);
+    std::vector<ItemWithVariableSize> items(num_items);
+    for (int i = 0; i < num_items; ++i) {
+      items[i] = {.index = i,
+                  .x = RandomItemInterval(random),
+                  .y = RandomItemInterval(random)};
+    }
+
+    // On a single set, the two items of a pair may come in any order.
+    std::vector<PairwiseRestriction> expected;
+    for (int i = 0; i < num_items; ++i) {
+      for (int j = i + 1; j < num_items; ++j) {
+        AppendPairwiseRestriction(items[i], items[j], &expected);
+      }
+    }
+    std::vector<PairwiseRestriction> results;
+    EXPECT_TRUE(AppendPairwiseRestrictions(items, &results));
+    for (PairwiseRestriction& result : results) {
+      if (result.first_index > result.second_index) result = Mirror(result);
+    }
+    EXPECT_THAT(results, UnorderedElementsAreArray(expected));
+
+    // On two sets, the item of the first set is always first.
+    const int split = absl::Uniform(random, 0, num_items + 1);
+    const absl::Span<const ItemWithVariableSize> first_items =
+        absl::MakeConstSpan(items).subspan(0, split);
+    const absl::Span<const ItemWithVariableSize> second_items =
+        absl::MakeConstSpan(items).subspan(split);
+    expected.clear();
+    for (const ItemWithVariableSize& item1 : first_items) {
+      for (const ItemWithVariableSize& item2 : second_items) {
+        AppendPairwiseRestriction(item1, item2, &expected);
+      }
+    }
+    results.clear();
+    EXPECT_TRUE(
+        AppendPairwiseRestrictions(first_items, second_items, &results));
+    EXPECT_THAT(results, UnorderedElementsAreArray(expected));
+  }
+}
+
+TEST(FindPairwiseRestrictionsTest, StopsWhenPairBudgetIsExhausted) {
+  // Three items that all overlap the others on x.
+  std::vector<ItemWithVariableSize> items;
+  for (int i = 0; i < 3; ++i) {
+    items.push_back({.index = i,
+                     .x = {.start_min = 0, .start_max = 1, .end_min = 5,
+                           .end_max = 6},
+                     .y = {.start_min = 10 * i, .start_max = 10 * i,
+                           .end_min = 10 * i + 1, .end_max = 10 * i + 1}});
+  }
+  std::vector<PairwiseRestriction> results;
+  int64_t pair_budget = 2;
+  EXPECT_FALSE(AppendPairwiseRestrictions(items, &results, &pair_budget));
+  EXPECT_EQ(pair_budget, 0);
+  pair_budget = 4;
+  EXPECT_TRUE(AppendPairwiseRestrictions(items, &results, &pair_budget));
+  EXPECT_EQ(pair_budget, 1);
+  // The budget is shared between calls.
+  EXPECT_FALSE(AppendPairwiseRestrictions(items, &results, &pair_budget));
+  EXPECT_TRUE(results.empty());
+}
+
 void BM_FindPairwiseRestrictions(benchmark::State& state) {
   absl::BitGen random;
   // In the vast majority of the cases the propagator doesn't find any pairwise
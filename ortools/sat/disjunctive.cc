@@ -17,7 +17,6 @@
 #include <utility>
 #include <vector>
 
-#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
@@ -619,9 +618,19 @@ bool DisjunctiveOverloadChecker::PropagateSubwindow(
   theta_tree_.Reset(num_events);
 
   // Introduce events by increasing end_max, check for overloads.
-  // If end_max is the same, we want to add high start-min first.
-  absl::c_reverse(task_by_increasing_end_max_);
-  absl::c_stable_sort(task_by_increasing_end_max_);
+  // If end_max is the same, we want to add high start-min first, that is the
+  // task with the highest event first.
+  //
+  // The tasks are pushed by increasing shifted start-min, which is usually
+  // close to the increasing end-max order, so IncrementalSort() is almost
+  // linear here.
+  IncrementalSort(task_by_increasing_end_max_.begin(),
+                  task_by_increasing_end_max_.end(),
+                  [this](const TaskTime a, const TaskTime b) {
+                    if (a.time != b.time) return a.time < b.time;
+                    return task_to_event_[a.task_index] >
+                           task_to_event_[b.task_index];
+                  });
   for (const auto task_time : task_by_increasing_end_max_) {
     const int current_task = task_time.task_index;
 
@@ -1440,9 +1449,11 @@ bool DisjunctiveNotLast::PropagateSubwindow() {
   // propagator.
   if (queue_size <= 1) return true;
 
+  // The window is sorted by start-min, which is usually close to the start-max
+  // order.
   task_by_increasing_start_max.resize(queue_size);
-  std::sort(task_by_increasing_start_max.begin(),
-            task_by_increasing_start_max.end());
+  IncrementalSort(task_by_increasing_start_max.begin(),
+                  task_by_increasing_start_max.end());
 
   task_set_.Clear();
   int queue_index = 0;
@@ -1629,8 +1640,11 @@ bool DisjunctiveEdgeFinding::PropagateSubwindow(IntegerValue window_end_min) {
   // If we have just 1 non-gray task, then this propagator does not propagate
   // more than the detectable precedences, so we abort early.
   if (task_by_increasing_end_max_.size() < 2) return true;
-  std::sort(task_by_increasing_end_max_.begin(),
-            task_by_increasing_end_max_.end());
+
+  // The window is sorted by start-min, which is usually close to the end-max
+  // order.
+  IncrementalSort(task_by_increasing_end_max_.begin(),
+                  task_by_increasing_end_max_.end());
 
   // Set up theta tree.
   //
@@ -1639,8 +1653,8 @@ bool DisjunctiveEdgeFinding::PropagateSubwindow(IntegerValue window_end_min) {
   // - All the non-gray task
   // - All the non-gray task + at most one gray task.
   //
-  // TODO(user): it should be faster to initialize it all at once rather
-  // than calling AddOrUpdate() n times.
+  // All the leaves are set first, and the internal nodes are computed once at
+  // the end, which is O(n) instead of O(n log n).
   const int window_size = window_.size();
   event_size_.clear();
   theta_tree_.Reset(window_size);
@@ -1650,13 +1664,15 @@ bool DisjunctiveEdgeFinding::PropagateSubwindow(IntegerValue window_end_min) {
     const IntegerValue energy_min = helper_->SizeMin(task);
     event_size_.push_back(energy_min);
     if (is_gray_[task]) {
-      theta_tree_.AddOrUpdateOptionalEvent(event, task_time.time, energy_min);
+      theta_tree_.DelayedAddOrUpdateOptionalEvent(event, task_time.time,
+                                                  energy_min);
     } else {
       non_gray_task_to_event_[task] = event;
-      theta_tree_.AddOrUpdateEvent(event, task_time.time, energy_min,
-                                   energy_min);
+      theta_tree_.DelayedAddOrUpdateEvent(event, task_time.time, energy_min,
+                                          energy_min);
     }
   }
+  theta_tree_.RecomputeTreeForDelayedOperations();
 
   // At each iteration we either transform a non-gray task into a gray one or
   // remove a gray task, so this loop is linear in complexity.
@@ -13,48 +13,119 @@
 
 #include "ortools/sat/drat_writer.h"
 
+#include <cstdint>
 #include <string>
+#include <utility>
+
 #if !defined(__PORTABLE_PLATFORM__)
+#include <thread>  // NOLINT
+
 #include "ortools/base/file.h"
 #include "ortools/base/helpers.h"
 #include "ortools/base/options.h"
 #endif  // !__PORTABLE_PLATFORM__
 #include "absl/log/check.h"
-#include "absl/strings/str_format.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "ortools/sat/sat_base.h"
 
 namespace operations_research {
 namespace sat {
 
+DratWriter::DratWriter(bool in_binary_format, File* output)
+    : in_binary_format_(in_binary_format), output_(output) {
+  buffer_.reserve(kBufferSize);
+#if !defined(__PORTABLE_PLATFORM__)
+  if (output_ != nullptr) {
+    writer_thread_ = std::thread([this]() { WriteBuffers(); });
+  }
+#endif  // !__PORTABLE_PLATFORM__
+}
+
 DratWriter::~DratWriter() {
   if (output_ != nullptr) {
+    FlushBuffer();
+    {
+      absl::MutexLock lock(&mutex_);
+      done_ = true;
+    }
 #if !defined(__PORTABLE_PLATFORM__)
-    CHECK_OK(file::WriteString(output_, buffer_, file::Defaults()));
+    writer_thread_.join();
     CHECK_OK(output_->Close(file::Defaults()));
 #endif  // !__PORTABLE_PLATFORM__
   }
 }
 
 void DratWriter::AddClause(absl::Span<const Literal> clause) {
+  if (in_binary_format_) buffer_ += 'a';
   WriteClause(clause);
 }
 
 void DratWriter::DeleteClause(absl::Span<const Literal> clause) {
-  buffer_ += "d ";
+  buffer_ += in_binary_format_ ? "d" : "d ";
   WriteClause(clause);
 }
 
 void DratWriter::WriteClause(absl::Span<const Literal> clause) {
-  for (const Literal literal : clause) {
-    absl::StrAppendFormat(&buffer_, "%d ", literal.SignedValue());
+  if (in_binary_format_) {
+    for (const Literal literal : clause) {
+      const uint64_t var = literal.Variable().value() + 1;
+      uint64_t value = 2 * var + (literal.IsPositive() ? 0 : 1);
+      while (value > 127) {
+        buffer_ += static_cast<char>(128 | (value & 127));
+        value >>= 7;
+      }
+      buffer_ += static_cast<char>(value);
+    }
+    buffer_ += '\0';
+  } else {
+    for (const Literal literal : clause) {
+      absl::StrAppend(&buffer_, literal.SignedValue(), " ");
+    }
+    buffer_ += "0\n";
   }
-  buffer_ += "0\n";
-  if (buffer_.size() > 10000) {
+  if (buffer_.size() > kBufferSize) FlushBuffer();
+}
+
+void DratWriter::FlushBuffer() {
+  if (buffer_.empty()) return;
+#if defined(__PORTABLE_PLATFORM__)
+  buffer_.clear();
+#else   // __PORTABLE_PLATFORM__
+  if (output_ == nullptr) {
+    buffer_.clear();
+    return;
+  }
+  std::string full_buffer;
+  full_buffer.reserve(kBufferSize);
+  std::swap(full_buffer, buffer_);
+
+  absl::MutexLock lock(&mutex_);
+  const auto has_room = [this]() ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+    return pending_buffers_.size() < kMaxPendingBuffers;
+  };
+  mutex_.Await(absl::Condition(&has_room));
+  pending_buffers_.push_back(std::move(full_buffer));
+#endif  // __PORTABLE_PLATFORM__
+}
+
+void DratWriter::WriteBuffers() {
+  while (true) {
+    std::string buffer;
+    {
+      absl::MutexLock lock(&mutex_);
+      const auto has_work = [this]() ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+        return done_ || !pending_buffers_.empty();
+      };
+      mutex_.Await(absl::Condition(&has_work));
+      if (pending_buffers_.empty()) return;  // done_ is true.
+      buffer = std::move(pending_buffers_.front());
+      pending_buffers_.pop_front();
+    }
 #if !defined(__PORTABLE_PLATFORM__)
-    CHECK_OK(file::WriteString(output_, buffer_, file::Defaults()));
+    CHECK_OK(file::WriteString(output_, buffer, file::Defaults()));
 #endif  // !__PORTABLE_PLATFORM__
-    buffer_.clear();
   }
 }
 
@@ -14,13 +14,18 @@
 #ifndef OR_TOOLS_SAT_DRAT_WRITER_H_
 #define OR_TOOLS_SAT_DRAT_WRITER_H_
 
+#include <deque>
 #include <string>
 
 #if !defined(__PORTABLE_PLATFORM__)
+#include <thread>  // NOLINT
+
 #include "ortools/base/file.h"
 #else
 class File {};
 #endif  // !__PORTABLE_PLATFORM__
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "ortools/sat/sat_base.h"
 
@@ -33,10 +38,14 @@ namespace sat {
 //
 // Note that DRAT proofs are often huge (can be GB), and take about as much time
 // to check as it takes for the solver to find the proof in the first place!
+//
+// To not slow down the solver, the proof is encoded in a memory buffer, and
+// full buffers are written to the output by a background thread. The solver
+// thread only waits if the writer falls behind by more than
+// kMaxPendingBuffers buffers.
 class DratWriter {
  public:
-  DratWriter(bool in_binary_format, File* output)
-      : in_binary_format_(in_binary_format), output_(output) {}
+  DratWriter(bool in_binary_format, File* output);
   ~DratWriter();
 
   // Writes a new clause to the DRAT output. Note that the RAT property is only
@@ -49,13 +58,34 @@ class DratWriter {
   void DeleteClause(absl::Span<const Literal> clause);
 
  private:
+  static constexpr int kBufferSize = 1 << 20;
+  static constexpr int kMaxPendingBuffers = 64;
+
   void WriteClause(absl::Span<const Literal> clause);
 
-  // TODO(user): Support binary format as proof in text format can be large.
+  // Hands over buffer_ to the writer thread.
+  void FlushBuffer();
+
+  // Main loop of the writer thread.
+  void WriteBuffers();
+
+  // In the binary format, each clause starts with 'a' or 'd' and each literal
+  // is encoded as 2 * variable + sign, in little-endian base 128 with the high
+  // bit set on all but the last byte. A zero byte ends the clause. This is
+  // usually 3 to 4 times smaller and much faster to produce than the text
+  // format.
   bool in_binary_format_;
   File* output_;
 
   std::string buffer_;
+
+  // Buffers waiting to be written by the writer thread.
+  absl::Mutex mutex_;
+  std::deque<std::string> pending_buffers_ ABSL_GUARDED_BY(mutex_);
+  bool done_ ABSL_GUARDED_BY(mutex_) = false;
+#if !defined(__PORTABLE_PLATFORM__)
+  std::thread writer_thread_;
+#endif  // !__PORTABLE_PLATFORM__
 };
 
 }  // namespace sat
@@ -0,0 +1,95 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/drat_writer.h"
+
+#include <string>
+
+#include "absl/log/check.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+#include "ortools/base/file.h"
+#include "ortools/base/helpers.h"
+#include "ortools/base/options.h"
+#include "ortools/base/path.h"
+#include "ortools/sat/sat_base.h"
+
+namespace operations_research {
+namespace sat {
+namespace {
+
+File* OpenForWriting(absl::string_view filename) {
+  File* file = nullptr;
+  CHECK_OK(file::Open(filename, "w", &file, file::Defaults()));
+  return file;
+}
+
+std::string ReadContents(absl::string_view filename) {
+  std::string contents;
+  CHECK_OK(file::GetContents(filename, &contents, file::Defaults()));
+  return contents;
+}
+
+TEST(DratWriterTest, BinaryFormat) {
+  const std::string filename =
+      file::JoinPath(::testing::TempDir(), "binary.drat");
+  {
+    DratWriter writer(/*in_binary_format=*/true, OpenForWriting(filename));
+    writer.AddClause({Literal(+1), Literal(-2)});
+    writer.AddClause({Literal(+100)});
+    writer.DeleteClause({Literal(-100)});
+  }
+
+  // Literal x (or -x) is encoded as 2 * x (or 2 * x + 1) in little-endian base
+  // 128, with the high bit set on all but the last byte: 200 is 0xC8 0x01.
+  const std::string expected = {'a', 0x02, 0x05, 0x00,
+                                'a', static_cast<char>(0xC8), 0x01, 0x00,
+                                'd', static_cast<char>(0xC9), 0x01, 0x00};
+  EXPECT_EQ(ReadContents(filename), expected);
+}
+
+TEST(DratWriterTest, TextFormat) {
+  const std::string filename =
+      file::JoinPath(::testing::TempDir(), "text.drat");
+  {
+    DratWriter writer(/*in_binary_format=*/false, OpenForWriting(filename));
+    writer.AddClause({Literal(+1), Literal(-2)});
+    writer.DeleteClause({Literal(+1), Literal(-2)});
+  }
+  EXPECT_EQ(ReadContents(filename), "1 -2 0\nd 1 -2 0\n");
+}
+
+TEST(DratWriterTest, ClosingWritesAllTheQueuedBuffers) {
+  const std::string filename =
+      file::JoinPath(::testing::TempDir(), "large.drat");
+
+  // Each clause takes 3 bytes, so this fills several buffers which are queued
+  // for the writer thread, plus a partial one which is only flushed on close.
+  const int num_clauses = 2'000'000 + 7;
+  {
+    DratWriter writer(/*in_binary_format=*/true, OpenForWriting(filename));
+    for (int i = 0; i < num_clauses; ++i) {
+      writer.AddClause({Literal(+1)});
+    }
+  }
+
+  const std::string contents = ReadContents(filename);
+  ASSERT_EQ(contents.size(), 3 * num_clauses);
+  for (int i = 0; i < num_clauses; ++i) {
+    ASSERT_EQ(contents.substr(3 * i, 3), std::string({'a', 0x02, 0x00}));
+  }
+}
+
+}  // namespace
+}  // namespace sat
+}  // namespace operations_research
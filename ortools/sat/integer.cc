@@ -30,7 +30,10 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/meta/type_traits.h"
+#include "absl/random/distributions.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
@@ -2149,6 +2152,10 @@ void GenericLiteralWatcher::UpdateCallingNeeds(Trail* trail) {
   modified_vars_.ClearAndResize(integer_trail_->NumIntegerVariables());
 }
 
+int64_t GenericLiteralWatcher::NextTimingGap() {
+  return absl::Uniform<int64_t>(timing_random_, 1, 2 * kTimingSamplingPeriod);
+}
+
 bool GenericLiteralWatcher::Propagate(Trail* trail) {
   // Only once per call to Propagate(), if we are at level zero, we might want
   // to call propagators even if the bounds didn't change.
@@ -2222,12 +2229,26 @@ bool GenericLiteralWatcher::Propagate(Trail* trail) {
       const int64_t old_integer_timestamp = integer_trail_->num_enqueues();
       const int64_t old_boolean_timestamp = trail->Index();
 
+      // We only read the clock once every kTimingSamplingPeriod calls on
+      // average.
+      int64_t start_ns = 0;
+      if (collect_statistics_) {
+        ++id_to_num_calls_[id];
+        if (--calls_before_next_timing_ == 0) {
+          calls_before_next_timing_ = NextTimingGap();
+          start_ns = absl::GetCurrentTimeNanos();
+        }
+      }
+
       // TODO(user): Maybe just provide one function Propagate(watch_indices) ?
       ++num_propagate_calls;
       const bool result =
           id_to_watch_indices_[id].empty()
               ? watchers_[id]->Propagate()
               : watchers_[id]->IncrementalPropagate(id_to_watch_indices_[id]);
+      if (start_ns != 0) {
+        id_to_sampled_time_ns_[id] += absl::GetCurrentTimeNanos() - start_ns;
+      }
       if (!result) {
         id_to_watch_indices_[id].clear();
         in_queue_[id] = false;
@@ -2324,6 +2345,18 @@ void GenericLiteralWatcher::Untrail(const Trail& trail, int trail_index) {
 }
 
 // Registers a propagator and returns its unique ids.
+void GenericLiteralWatcher::SetRegistrationTag(absl::string_view tag) {
+  if (tags_[current_tag_] == tag) return;
+  for (int i = 0; i < tags_.size(); ++i) {
+    if (tags_[i] == tag) {
+      current_tag_ = i;
+      return;
+    }
+  }
+  current_tag_ = tags_.size();
+  tags_.push_back(std::string(tag));
+}
+
 int GenericLiteralWatcher::Register(PropagatorInterface* propagator) {
   const int id = watchers_.size();
   watchers_.push_back(propagator);
@@ -2338,6 +2371,10 @@ int GenericLiteralWatcher::Register(PropagatorInterface* propagator) {
   id_to_priority_.push_back(1);
   id_to_idempotence_.push_back(true);
 
+  id_to_tag_.push_back(current_tag_);
+  id_to_num_calls_.push_back(0);
+  id_to_sampled_time_ns_.push_back(0);
+
   // Call this propagator at least once the next time Propagate() is called.
   //
   // TODO(user): This initial propagation does not respect any later priority
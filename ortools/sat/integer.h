@@ -31,6 +31,7 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
@@ -40,6 +41,7 @@
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
 #include "ortools/util/bitset.h"
+#include "ortools/util/random_engine.h"
 #include "ortools/util/rev.h"
 #include "ortools/util/sorted_interval_list.h"
 #include "ortools/util/strong_integers.h"
@@ -1235,11 +1237,40 @@ class GenericLiteralWatcher final : public SatPropagator {
   // Add the given propagator to its queue.
   void CallOnNextPropagate(int id);
 
+  // The propagators registered after this call are tagged with the given name,
+  // which is used to aggregate their statistics. The loader uses the type of
+  // the constraint being loaded. An empty tag is reported as "other".
+  void SetRegistrationTag(absl::string_view tag);
+
+  // Starts to count the number of calls of each propagator, and to estimate
+  // the time spent in them. To keep the overhead low, only one call out of
+  // kTimingSamplingPeriod on average is timed. This is disabled by default.
+  void EnableStatistics() {
+    collect_statistics_ = true;
+    calls_before_next_timing_ = NextTimingGap();
+  }
+  bool StatisticsAreEnabled() const { return collect_statistics_; }
+  absl::string_view PropagatorTag(int id) const {
+    return tags_[id_to_tag_[id]];
+  }
+  int64_t PropagatorNumCalls(int id) const { return id_to_num_calls_[id]; }
+  double PropagatorEstimatedTime(int id) const {
+    return 1e-9 * static_cast<double>(id_to_sampled_time_ns_[id] *
+                                      kTimingSamplingPeriod);
+  }
+
  private:
+  static constexpr int64_t kTimingSamplingPeriod = 16;
+
   // Updates queue_ and in_queue_ with the propagator ids that need to be
   // called.
   void UpdateCallingNeeds(Trail* trail);
 
+  // The number of calls until the next timed one is drawn uniformly in
+  // [1, 2 * kTimingSamplingPeriod - 1]. A fixed gap could always time the same
+  // propagator when they are woken up in a periodic pattern.
+  int64_t NextTimingGap();
+
   TimeLimit* time_limit_;
   IntegerTrail* integer_trail_;
   RevIntRepository* rev_int_repository_;
@@ -1290,6 +1321,18 @@ class GenericLiteralWatcher final : public SatPropagator {
   std::function<bool()> stop_propagation_callback_;
 
   std::vector<bool*> bool_to_reset_on_backtrack_;
+
+  // Statistics, see EnableStatistics().
+  bool collect_statistics_ = false;
+  // Note that we do not use the model random generator so that enabling the
+  // statistics does not change the search.
+  random_engine_t timing_random_;
+  int64_t calls_before_next_timing_ = 0;
+  int current_tag_ = 0;
+  std::vector<std::string> tags_ = {""};
+  std::vector<int> id_to_tag_;
+  std::vector<int64_t> id_to_num_calls_;
+  std::vector<int64_t> id_to_sampled_time_ns_;
 };
 
 // ============================================================================
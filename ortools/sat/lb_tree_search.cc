@@ -18,6 +18,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -42,6 +43,7 @@
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
+#include "ortools/sat/work_assignment.h"
 #include "ortools/util/strong_integers.h"
 #include "ortools/util/time_limit.h"
 
@@ -62,7 +64,15 @@ LbTreeSearch::LbTreeSearch(Model* model)
       pseudo_costs_(model->GetOrCreate<PseudoCosts>()),
       sat_decision_(model->GetOrCreate<SatDecisionPolicy>()),
       search_helper_(model->GetOrCreate<IntegerSearchHelper>()),
-      parameters_(*model->GetOrCreate<SatParameters>()) {
+      parameters_(*model->GetOrCreate<SatParameters>()),
+      mapping_(model->GetOrCreate<CpModelMapping>()) {
+  if (parameters_.share_lb_tree_search_nodes()) {
+    shared_nodes_ = model->Mutable<SharedLbTreeSearchNodes>();
+    if (shared_nodes_ != nullptr) {
+      shared_nodes_id_ = shared_nodes_->RegisterNewId();
+    }
+  }
+
   // We should create this class only in the presence of an objective.
   //
   // TODO(user): Starts with an initial variable score for all variable in
@@ -324,7 +334,7 @@ void LbTreeSearch::MarkSubtreeAsDeleted(NodeIndex root) {
 }
 
 std::string LbTreeSearch::SmallProgressString() const {
-  return absl::StrCat(
+  std::string result = absl::StrCat(
       "nodes=", num_nodes_in_tree_, "/", nodes_.size(),
       " rc=", num_rc_detected_, " decisions=", num_decisions_taken_,
       " @root=", num_back_to_root_node_, " restarts=", num_full_restarts_,
@@ -332,6 +342,51 @@ std::string LbTreeSearch::SmallProgressString() const {
       FormatCounter(num_lp_iters_save_basis_), ", ",
       FormatCounter(num_lp_iters_first_branch_), ", ",
       FormatCounter(num_lp_iters_dive_), "]");
+  if (shared_nodes_ != nullptr) {
+    absl::StrAppend(&result, " shared=[", num_shared_nodes_exported_, ", ",
+                    num_shared_nodes_imported_, "]");
+  }
+  return result;
+}
+
+// The node is reached by assigning the decisions of the first `level` nodes of
+// the current branch. We only share nodes close to the root: they are the ones
+// that save the most work to the other workers, and their clauses are short.
+void LbTreeSearch::ExportNode(int level, IntegerValue objective_lb) {
+  const int kMaxSharedNodeDepth = 10;
+  if (level == 0 || level > kMaxSharedNodeDepth) return;
+  tmp_shared_decisions_.clear();
+  for (int i = 0; i < level; ++i) {
+    const Literal literal = nodes_[current_branch_[i]].Decision();
+    const std::optional<ProtoLiteral> decision = ProtoLiteral::Encode(
+        assignment_.LiteralIsTrue(literal) ? literal : literal.Negated(),
+        mapping_, integer_encoder_);
+    if (!decision.has_value()) return;
+    tmp_shared_decisions_.push_back(*decision);
+  }
+  shared_nodes_->AddNode(shared_nodes_id_, tmp_shared_decisions_,
+                         objective_lb);
+  ++num_shared_nodes_exported_;
+}
+
+bool LbTreeSearch::ImportSharedNodes() {
+  DCHECK_EQ(sat_solver_->CurrentDecisionLevel(), 0);
+  std::vector<Literal> clause;
+  for (const auto& [decisions, objective_lb] :
+       shared_nodes_->GetNewNodes(shared_nodes_id_)) {
+    if (objective_lb <= integer_trail_->LevelZeroLowerBound(objective_var_)) {
+      continue;
+    }
+    clause.clear();
+    for (const ProtoLiteral& decision : decisions) {
+      clause.push_back(decision.Decode(mapping_, integer_encoder_).Negated());
+    }
+    clause.push_back(integer_encoder_->GetOrCreateAssociatedLiteral(
+        IntegerLiteral::GreaterOrEqual(objective_var_, objective_lb)));
+    if (!sat_solver_->AddProblemClause(clause)) return false;
+    ++num_shared_nodes_imported_;
+  }
+  return sat_solver_->FinishPropagation();
 }
 
 std::function<void()> LbTreeSearch::UpdateLpIters(int64_t* counter) {
@@ -377,6 +432,9 @@ bool LbTreeSearch::LevelZeroLogic() {
     }
   }
 
+  // Import the subtrees closed by the other lb_tree_search workers.
+  if (shared_nodes_ != nullptr && !ImportSharedNodes()) return false;
+
   // If the search has not just been restarted (in which case nodes_ would be
   // empty), and if we are at level zero (either naturally, or if the
   // backtrack level was set to zero in the above code), let's run a different
@@ -590,6 +648,14 @@ SatSolver::Status LbTreeSearch::Search(
            (current_branch_.size() > 1 &&
             nodes_[current_branch_.back()].MinObjective() >
                 current_objective_lb_)) {
+      // The subtree under the current decisions is closed, tell the other
+      // workers about it.
+      const int level = current_branch_.size() - 1;
+      const IntegerValue bound = nodes_[current_branch_.back()].MinObjective();
+      if (shared_nodes_ != nullptr && bound > current_objective_lb_ &&
+          level <= sat_solver_->CurrentDecisionLevel()) {
+        ExportNode(level, bound);
+      }
       current_branch_.pop_back();
     }
 
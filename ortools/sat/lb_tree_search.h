@@ -26,6 +26,7 @@
 #include "absl/types/span.h"
 #include "ortools/base/strong_vector.h"
 #include "ortools/glop/variables_info.h"
+#include "ortools/sat/cp_model_mapping.h"
 #include "ortools/sat/integer.h"
 #include "ortools/sat/integer_base.h"
 #include "ortools/sat/integer_search.h"
@@ -38,6 +39,7 @@
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
+#include "ortools/sat/work_assignment.h"
 #include "ortools/util/strong_integers.h"
 #include "ortools/util/time_limit.h"
 
@@ -170,6 +172,14 @@ class LbTreeSearch {
   // Update the bounds on the given nodes by using reduced costs if possible.
   void ExploitReducedCosts(NodeIndex n);
 
+  // Shares with the other workers that the node at the given level of the
+  // current branch has an objective lower bound of objective_lb.
+  void ExportNode(int level, IntegerValue objective_lb);
+
+  // Adds one clause "decisions => objective >= lb" per node proven by the
+  // other workers. This must be called at level zero. Returns false if UNSAT.
+  bool ImportSharedNodes();
+
   // Returns a small number of decision needed to reach the same conflict.
   // We basically reduce the number of decision at each level to 1.
   std::vector<Literal> ExtractDecisions(int base_level,
@@ -200,6 +210,14 @@ class LbTreeSearch {
   IntegerSearchHelper* search_helper_;
   IntegerVariable objective_var_;
   const SatParameters& parameters_;
+  CpModelMapping* mapping_;
+
+  // Only non-null if share_lb_tree_search_nodes is true.
+  SharedLbTreeSearchNodes* shared_nodes_ = nullptr;
+  int shared_nodes_id_ = -1;
+  std::vector<ProtoLiteral> tmp_shared_decisions_;
+  int64_t num_shared_nodes_exported_ = 0;
+  int64_t num_shared_nodes_imported_ = 0;
 
   // This can stay null. Otherwise it will be the lp constraint with
   // objective_var_ as objective.
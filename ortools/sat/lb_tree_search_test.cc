@@ -31,6 +31,25 @@ TEST(LbTreeSearch, BooleanLinearOptimizationProblem) {
   EXPECT_EQ(response.status(), CpSolverStatus::OPTIMAL);
 }
 
+TEST(LbTreeSearch, SeveralWorkersSharingNodes) {
+  const CpModelProto model_proto = RandomLinearProblem(50, 50);
+  SatParameters params;
+  params.set_num_workers(4);
+  params.add_subsolvers("lb_tree_search");
+  params.add_subsolvers("lb_tree_search");
+  params.add_subsolvers("lb_tree_search");
+  params.add_subsolvers("default_lp");
+  params.set_share_lb_tree_search_nodes(true);
+  const CpSolverResponse response = SolveWithParameters(model_proto, params);
+  EXPECT_EQ(response.status(), CpSolverStatus::OPTIMAL);
+
+  params.set_num_workers(1);
+  params.clear_subsolvers();
+  const CpSolverResponse reference = SolveWithParameters(model_proto, params);
+  EXPECT_EQ(reference.status(), CpSolverStatus::OPTIMAL);
+  EXPECT_EQ(response.objective_value(), reference.objective_value());
+}
+
 }  // namespace
 }  // namespace sat
 }  // namespace operations_research
@@ -331,12 +331,18 @@ LinearConstraintManager::ConstraintIndex LinearConstraintManager::Add(
       bool tightened = false;
       if (ct.lb > constraint_infos_[ct_index].constraint.lb) {
         tightened = true;
-        if (constraint_infos_[ct_index].is_in_lp) current_lp_is_changed_ = true;
+        if (constraint_infos_[ct_index].is_in_lp) {
+          current_lp_is_changed_ = true;
+          current_lp_rows_are_changed_ = true;
+        }
         constraint_infos_[ct_index].constraint.lb = ct.lb;
       }
       if (ct.ub < constraint_infos_[ct_index].constraint.ub) {
         tightened = true;
-        if (constraint_infos_[ct_index].is_in_lp) current_lp_is_changed_ = true;
+        if (constraint_infos_[ct_index].is_in_lp) {
+          current_lp_is_changed_ = true;
+          current_lp_rows_are_changed_ = true;
+        }
         constraint_infos_[ct_index].constraint.ub = ct.ub;
       }
       if (added != nullptr) *added = tightened;
@@ -368,6 +374,7 @@ bool LinearConstraintManager::UpdateConstraintLb(glop::RowIndex index_in_lp,
   if (new_lb <= info.constraint.lb) return false;
   ++num_constraint_updates_;
   current_lp_is_changed_ = true;
+  current_lp_rows_are_changed_ = true;
   info.constraint.lb = new_lb;
   return true;
 }
@@ -379,6 +386,7 @@ bool LinearConstraintManager::UpdateConstraintUb(glop::RowIndex index_in_lp,
   if (new_ub >= info.constraint.ub) return false;
   ++num_constraint_updates_;
   current_lp_is_changed_ = true;
+  current_lp_rows_are_changed_ = true;
   info.constraint.ub = new_ub;
   return true;
 }
@@ -442,6 +450,12 @@ bool LinearConstraintManager::AddCut(LinearConstraint ct, std::string type_name,
   // important.
   if (PossibleOverflow(integer_trail_, ct)) return false;
 
+  if (buffer_cuts_) {
+    buffered_cuts_.push_back(
+        {std::move(ct), std::move(type_name), std::move(extra_info)});
+    return true;
+  }
+
   bool added = false;
   const ConstraintIndex ct_index = Add(std::move(ct), &added);
 
@@ -466,6 +480,15 @@ bool LinearConstraintManager::AddCut(LinearConstraint ct, std::string type_name,
   return true;
 }
 
+void LinearConstraintManager::TransferBufferedCutsTo(
+    LinearConstraintManager* manager) {
+  for (BufferedCut& cut : buffered_cuts_) {
+    manager->AddCut(std::move(cut.ct), std::move(cut.type_name),
+                    std::move(cut.extra_info));
+  }
+  buffered_cuts_.clear();
+}
+
 void LinearConstraintManager::PermanentlyRemoveSomeConstraints() {
   std::vector<double> deletable_constraint_counts;
   for (ConstraintIndex i(0); i < constraint_infos_.size(); ++i) {
@@ -733,7 +756,10 @@ bool LinearConstraintManager::ChangeLp(glop::BasisState* solution_state,
           ComputeL2Norm(constraint_infos_[i].constraint);
       FillDerivedFields(&constraint_infos_[i]);
 
-      if (constraint_infos_[i].is_in_lp) current_lp_is_changed_ = true;
+      if (constraint_infos_[i].is_in_lp) {
+        current_lp_is_changed_ = true;
+        current_lp_rows_are_changed_ = true;
+      }
       equiv_constraints_.erase(constraint_infos_[i].hash);
       constraint_infos_[i].hash =
           ComputeHashOfTerms(constraint_infos_[i].constraint);
@@ -815,8 +841,12 @@ bool LinearConstraintManager::ChangeLp(glop::BasisState* solution_state,
   // over the just deleted constraints.
   if (MaybeRemoveSomeInactiveConstraints(solution_state)) {
     current_lp_is_changed_ = true;
+    current_lp_rows_are_changed_ = true;
   }
 
+  // From now on, we only append new constraints to the LP.
+  last_change_only_added_constraints_ = !current_lp_rows_are_changed_;
+
   // Note that the algo below is in O(limit * new_constraint). In order to
   // limit spending too much time on this, we first sort all the constraints
   // with an imprecise score (no orthogonality), then limit the size of the
@@ -941,6 +971,7 @@ bool LinearConstraintManager::ChangeLp(glop::BasisState* solution_state,
   // already inside changed (simplification or tighter bounds).
   if (current_lp_is_changed_) {
     current_lp_is_changed_ = false;
+    current_lp_rows_are_changed_ = false;
     return true;
   }
   return false;
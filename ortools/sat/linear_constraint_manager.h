@@ -214,6 +214,19 @@ class LinearConstraintManager {
   bool AddCut(LinearConstraint ct, std::string type_name,
               std::string extra_info = "");
 
+  // When enabled, AddCut() only performs its efficacy checks and then buffers
+  // the cut instead of adding it to this manager. TransferBufferedCutsTo() can
+  // later add all the buffered cuts, in order, to another manager. Note that
+  // AddCut() then returns true for all the cuts passing the efficacy checks,
+  // even if they will later be ignored as duplicates.
+  //
+  // This is used to run cut generators in parallel, each of them being given
+  // its own "buffer" manager. Note that in this mode, AddCut() only reads the
+  // shared LP values and the level zero bounds, so it is thread-safe as long as
+  // these are not modified.
+  void EnableCutBuffering() { buffer_cuts_ = true; }
+  void TransferBufferedCutsTo(LinearConstraintManager* manager);
+
   // These must be level zero bounds.
   bool UpdateConstraintLb(glop::RowIndex index_in_lp, IntegerValue new_lb);
   bool UpdateConstraintUb(glop::RowIndex index_in_lp, IntegerValue new_ub);
@@ -237,6 +250,14 @@ class LinearConstraintManager {
   bool ChangeLp(glop::BasisState* solution_state,
                 int* num_new_constraints = nullptr);
 
+  // Returns true if the last call to ChangeLp() that returned true only
+  // appended new constraints at the end of LpConstraints(), all the constraints
+  // that were already there being unchanged (same position, terms and bounds).
+  // In this case, the LP can be updated incrementally.
+  bool LastChangeOnlyAddedConstraints() const {
+    return last_change_only_added_constraints_;
+  }
+
   // This can be called initially to add all the current constraint to the LP
   // returned by GetLp().
   void AddAllConstraintsToLp();
@@ -324,6 +345,11 @@ class LinearConstraintManager {
   // Set at true by Add()/SimplifyConstraint() and at false by ChangeLp().
   bool current_lp_is_changed_ = false;
 
+  // Same as current_lp_is_changed_ but only set when a constraint already in
+  // the LP is modified or removed. See LastChangeOnlyAddedConstraints().
+  bool current_lp_rows_are_changed_ = false;
+  bool last_change_only_added_constraints_ = false;
+
   // Optimization to avoid calling SimplifyConstraint() when not needed.
   int64_t last_simplification_timestamp_ = 0;
 
@@ -350,6 +376,15 @@ class LinearConstraintManager {
   int64_t num_add_cut_calls_ = 0;
   absl::btree_map<std::string, int> type_to_num_cuts_;
 
+  // See EnableCutBuffering().
+  struct BufferedCut {
+    LinearConstraint ct;
+    std::string type_name;
+    std::string extra_info;
+  };
+  bool buffer_cuts_ = false;
+  std::vector<BufferedCut> buffered_cuts_;
+
   bool objective_is_defined_ = false;
   bool objective_norm_computed_ = false;
   double objective_l2_norm_ = 0.0;
@@ -218,6 +218,43 @@ TEST(LinearConstraintManagerTest, OnlyAddInfeasibleConstraints) {
   EXPECT_EQ(state.statuses[glop::ColIndex(3)], glop::VariableStatus::BASIC);
 }
 
+TEST(LinearConstraintManagerTest, LastChangeOnlyAddedConstraints) {
+  Model model;
+  LinearConstraintManager manager(&model);
+  const IntegerVariable x = model.Add(NewIntegerVariable(-10, 10));
+  const IntegerVariable y = model.Add(NewIntegerVariable(-10, 10));
+  SetLpValue(x, -1.0, &model);
+  SetLpValue(y, 0.0, &model);
+
+  LinearConstraintBuilder ct_one(IntegerValue(0), IntegerValue(10));
+  ct_one.AddTerm(x, IntegerValue(2));
+  ct_one.AddTerm(y, IntegerValue(3));
+  manager.Add(ct_one.Build());
+
+  glop::BasisState state;
+  state.statuses.resize(glop::ColIndex(2));
+  EXPECT_TRUE(manager.ChangeLp(&state));
+  EXPECT_TRUE(manager.LastChangeOnlyAddedConstraints());
+
+  // A new violated constraint is appended after the existing one.
+  LinearConstraintBuilder ct_two(IntegerValue(0), IntegerValue(6));
+  ct_two.AddTerm(y, IntegerValue(3));
+  ct_two.AddTerm(x, IntegerValue(1));
+  manager.Add(ct_two.Build());
+  EXPECT_TRUE(manager.ChangeLp(&state));
+  EXPECT_THAT(manager.LpConstraints(),
+              ElementsAre(ConstraintIndex(0), ConstraintIndex(1)));
+  EXPECT_TRUE(manager.LastChangeOnlyAddedConstraints());
+
+  // Tightening a constraint already in the LP is not an append only change.
+  LinearConstraintBuilder ct_three(IntegerValue(0), IntegerValue(8));
+  ct_three.AddTerm(x, IntegerValue(2));
+  ct_three.AddTerm(y, IntegerValue(3));
+  manager.Add(ct_three.Build());
+  EXPECT_TRUE(manager.ChangeLp(&state));
+  EXPECT_FALSE(manager.LastChangeOnlyAddedConstraints());
+}
+
 TEST(LinearConstraintManagerTest, OnlyAddOrthogonalConstraints) {
   Model model;
   model.GetOrCreate<SatParameters>()->set_min_orthogonality_for_lp_constraints(
@@ -294,6 +331,41 @@ TEST(LinearConstraintManagerTest, RemoveIneffectiveCuts) {
   EXPECT_EQ(state.statuses.size(), glop::ColIndex(2));
 }
 
+TEST(LinearConstraintManagerTest, BufferedCutsAreTransferredInOrder) {
+  Model model;
+  LinearConstraintManager manager(&model);
+  LinearConstraintManager buffer(&model);
+  buffer.EnableCutBuffering();
+  const IntegerVariable x = model.Add(NewIntegerVariable(0, 10));
+  const IntegerVariable y = model.Add(NewIntegerVariable(0, 10));
+  SetLpValue(x, 5.0, &model);
+  SetLpValue(y, 5.0, &model);
+
+  LinearConstraintBuilder ct_one(IntegerValue(0), IntegerValue(3));
+  ct_one.AddTerm(x, IntegerValue(1));
+  EXPECT_TRUE(buffer.AddCut(ct_one.Build(), "One"));
+
+  // Not violated, so not even buffered.
+  LinearConstraintBuilder ct_two(IntegerValue(0), IntegerValue(20));
+  ct_two.AddTerm(y, IntegerValue(1));
+  EXPECT_FALSE(buffer.AddCut(ct_two.Build(), "Two"));
+
+  LinearConstraintBuilder ct_three(IntegerValue(0), IntegerValue(4));
+  ct_three.AddTerm(y, IntegerValue(1));
+  EXPECT_TRUE(buffer.AddCut(ct_three.Build(), "Three"));
+  EXPECT_TRUE(buffer.AllConstraints().empty());
+
+  buffer.TransferBufferedCutsTo(&manager);
+  ASSERT_EQ(manager.AllConstraints().size(), 2);
+  EXPECT_EQ(manager.AllConstraints()[ConstraintIndex(0)].constraint.vars[0], x);
+  EXPECT_EQ(manager.AllConstraints()[ConstraintIndex(1)].constraint.vars[0], y);
+  EXPECT_EQ(manager.num_cuts(), 2);
+
+  // The buffer is cleared by the transfer.
+  buffer.TransferBufferedCutsTo(&manager);
+  EXPECT_EQ(manager.AllConstraints().size(), 2);
+}
+
 TEST(LinearConstraintManagerTest, ObjectiveParallelism) {
   Model model;
   LinearConstraintManager manager(&model);
@@ -31,14 +31,18 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/numeric/int128.h"
+#include "absl/random/distributions.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
 #include "ortools/algorithms/binary_search.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/revised_simplex.h"
 #include "ortools/glop/status.h"
@@ -481,8 +485,9 @@ void LinearProgrammingConstraint::SetObjectiveCoefficient(IntegerVariable ivar,
 // are equivalent.
 //
 // TODO(user): On TSP/VRP with a lot of cuts, this can take 20% of the overall
-// running time. We should be able to almost remove most of this from the
-// profile by being more incremental (modulo LP scaling).
+// running time. When we only add new cuts, we now use the incremental
+// AddNewConstraintsFromConstraintManager() instead, but we could also be
+// incremental when cuts are removed.
 //
 // TODO(user): A longer term idea for LP with a lot of variables is to not
 // add all variables to each LP solve and do some "sifting". That can be useful
@@ -497,42 +502,7 @@ bool LinearProgrammingConstraint::CreateLpFromConstraintManager() {
   infinity_norms_.clear();
   const auto& all_constraints = constraint_manager_.AllConstraints();
   for (const auto index : constraint_manager_.LpConstraints()) {
-    const LinearConstraint& ct = all_constraints[index].constraint;
-    if (ct.lb > ct.ub) {
-      VLOG(1) << "Trivial infeasible bound in an LP constraint";
-      return false;
-    }
-
-    integer_lp_.push_back(LinearConstraintInternal());
-    LinearConstraintInternal& new_ct = integer_lp_.back();
-    new_ct.lb = ct.lb;
-    new_ct.ub = ct.ub;
-    new_ct.lb_is_trivial = all_constraints[index].lb_is_trivial;
-    new_ct.ub_is_trivial = all_constraints[index].ub_is_trivial;
-
-    IntegerValue infinity_norm = 0;
-    infinity_norm = std::max(infinity_norm, IntTypeAbs(ct.lb));
-    infinity_norm = std::max(infinity_norm, IntTypeAbs(ct.ub));
-    new_ct.start_in_buffer = integer_lp_cols_.size();
-
-    // TODO(user): Make sure we don't have empty constraint!
-    // this currently can happen in some corner cases.
-    const int size = ct.num_terms;
-    new_ct.num_terms = size;
-    for (int i = 0; i < size; ++i) {
-      // We only use positive variable inside this class.
-      const IntegerVariable var = ct.vars[i];
-      const IntegerValue coeff = ct.coeffs[i];
-      infinity_norm = std::max(infinity_norm, IntTypeAbs(coeff));
-      integer_lp_cols_.push_back(GetMirrorVariable(var));
-      integer_lp_coeffs_.push_back(coeff);
-    }
-    infinity_norms_.push_back(infinity_norm);
-
-    // It is important to keep lp_data_ "clean".
-    DCHECK(std::is_sorted(
-        integer_lp_cols_.data() + new_ct.start_in_buffer,
-        integer_lp_cols_.data() + new_ct.start_in_buffer + new_ct.num_terms));
+    if (!AppendToIntegerLp(all_constraints[index])) return false;
   }
 
   // We remove fixed variables from the objective. This should help the LP
@@ -595,11 +565,132 @@ bool LinearProgrammingConstraint::CreateLpFromConstraintManager() {
   return true;
 }
 
+bool LinearProgrammingConstraint::AppendToIntegerLp(
+    const LinearConstraintManager::ConstraintInfo& constraint_info) {
+  const LinearConstraint& ct = constraint_info.constraint;
+  if (ct.lb > ct.ub) {
+    VLOG(1) << "Trivial infeasible bound in an LP constraint";
+    return false;
+  }
+
+  integer_lp_.push_back(LinearConstraintInternal());
+  LinearConstraintInternal& new_ct = integer_lp_.back();
+  new_ct.lb = ct.lb;
+  new_ct.ub = ct.ub;
+  new_ct.lb_is_trivial = constraint_info.lb_is_trivial;
+  new_ct.ub_is_trivial = constraint_info.ub_is_trivial;
+
+  IntegerValue infinity_norm = 0;
+  infinity_norm = std::max(infinity_norm, IntTypeAbs(ct.lb));
+  infinity_norm = std::max(infinity_norm, IntTypeAbs(ct.ub));
+  new_ct.start_in_buffer = integer_lp_cols_.size();
+
+  // TODO(user): Make sure we don't have empty constraint!
+  // this currently can happen in some corner cases.
+  const int size = ct.num_terms;
+  new_ct.num_terms = size;
+  for (int i = 0; i < size; ++i) {
+    // We only use positive variable inside this class.
+    const IntegerVariable var = ct.vars[i];
+    const IntegerValue coeff = ct.coeffs[i];
+    infinity_norm = std::max(infinity_norm, IntTypeAbs(coeff));
+    integer_lp_cols_.push_back(GetMirrorVariable(var));
+    integer_lp_coeffs_.push_back(coeff);
+  }
+  infinity_norms_.push_back(infinity_norm);
+
+  // It is important to keep lp_data_ "clean".
+  DCHECK(std::is_sorted(
+      integer_lp_cols_.data() + new_ct.start_in_buffer,
+      integer_lp_cols_.data() + new_ct.start_in_buffer + new_ct.num_terms));
+  return true;
+}
+
+bool LinearProgrammingConstraint::AddNewConstraintsFromConstraintManager() {
+  const int num_cols = integer_variables_.size();
+  const int old_num_rows = integer_lp_.size();
+  const auto& all_constraints = constraint_manager_.AllConstraints();
+  const auto& lp_constraints = constraint_manager_.LpConstraints();
+  DCHECK_GE(lp_constraints.size(), old_num_rows);
+  for (int i = old_num_rows; i < lp_constraints.size(); ++i) {
+    if (!AppendToIntegerLp(all_constraints[lp_constraints[i]])) return false;
+  }
+  const int num_rows = integer_lp_.size();
+
+  // Equilibrate the new rows using the current column factors. This is the
+  // same as the last row step of ComputeIntegerLpScalingFactors().
+  IntegerValue* coeffs = integer_lp_coeffs_.data();
+  glop::ColIndex* cols = integer_lp_cols_.data();
+  row_factors_.resize(num_rows, 1.0);
+  for (int row = old_num_rows; row < num_rows; ++row) {
+    double max_scaled = 0.0;
+    const LinearConstraintInternal& ct = integer_lp_[RowIndex(row)];
+    for (int i = 0; i < ct.num_terms; ++i) {
+      const int index = ct.start_in_buffer + i;
+      const int col = cols[index].value();
+      const double coeff = static_cast<double>(coeffs[index].value());
+      max_scaled = std::max(max_scaled, col_factors_[col] * std::abs(coeff));
+    }
+    if (ct.num_terms == 0) continue;
+    row_factors_[row] = 1.0 / max_scaled;
+  }
+
+  // Append the new rows to the transposed matrix. The old columns of the
+  // transposed matrix (i.e. the old rows) are untouched.
+  glop::CompactSparseMatrix* data =
+      simplex_.MutableTransposedMatrixWithSlackForNewRows();
+  data->IncreaseNumRows(glop::RowIndex(num_cols + num_rows));
+  for (int row = old_num_rows; row < num_rows; ++row) {
+    const LinearConstraintInternal& ct = integer_lp_[RowIndex(row)];
+    const double row_factor = row_factors_[row];
+    for (int i = 0; i < ct.num_terms; ++i) {
+      const int index = ct.start_in_buffer + i;
+      const int col = cols[index].value();
+      const double coeff = static_cast<double>(coeffs[index].value());
+      data->AddEntryToCurrentColumn(RowIndex(col),
+                                    row_factor * col_factors_[col] * coeff);
+    }
+    data->AddEntryToCurrentColumn(RowIndex(num_cols + row), 1.0);
+    data->CloseCurrentColumn();
+  }
+
+  // The slacks have a zero objective, so the objective is unchanged from the
+  // simplex point of view.
+  const glop::ColIndex num_cols_with_slacks(num_cols + num_rows);
+  obj_with_slack_.resize(num_cols_with_slacks, 0.0);
+
+  // The bounds of the new slacks must be scaled like in FillLpData() and then
+  // like in the ContainOneBoundScaling() that was done on the full LP.
+  simplex_.MutableLowerBounds()->resize(num_cols_with_slacks);
+  simplex_.MutableUpperBounds()->resize(num_cols_with_slacks);
+  Fractional* lb_with_slack = simplex_.MutableLowerBounds()->data();
+  Fractional* ub_with_slack = simplex_.MutableUpperBounds()->data();
+  const double infinity = std::numeric_limits<double>::infinity();
+  const double bound_factor = scaler_.BoundsScalingFactor();
+  for (int row = old_num_rows; row < num_rows; ++row) {
+    const LinearConstraintInternal& ct = integer_lp_[glop::RowIndex(row)];
+    const double factor = row_factors_[row] * bound_factor;
+    lb_with_slack[num_cols + row] =
+        ct.ub_is_trivial ? -infinity : ToDouble(-ct.ub) * factor;
+    ub_with_slack[num_cols + row] =
+        ct.lb_is_trivial ? +infinity : ToDouble(-ct.lb) * factor;
+  }
+
+  // Note that this keeps the objective and bound scaling factors.
+  scaler_.ConfigureFromFactors(row_factors_, col_factors_);
+
+  VLOG(3) << "LP relaxation: " << integer_lp_.size() << " x "
+          << integer_variables_.size() << ". "
+          << num_rows - old_num_rows << " rows added incrementally.";
+  return true;
+}
+
 // TODO(user): This is a duplicate of glop scaling code, but it allows to
 // work directly on our representation...
 void LinearProgrammingConstraint::ComputeIntegerLpScalingFactors() {
   const int num_rows = integer_lp_.size();
   const int num_cols = integer_variables_.size();
+  num_rows_at_last_scaling_ = num_rows;
 
   // Assign vectors.
   const double infinity = std::numeric_limits<double>::infinity();
@@ -832,6 +923,8 @@ void LinearProgrammingConstraint::SetLevel(int level) {
 
 void LinearProgrammingConstraint::AddCutGenerator(CutGenerator generator) {
   cut_generators_.push_back(std::move(generator));
+  cut_generator_num_calls_.push_back(0);
+  cut_generator_time_ns_.push_back(0);
 }
 
 bool LinearProgrammingConstraint::IncrementalPropagate(
@@ -922,6 +1015,103 @@ void LinearProgrammingConstraint::UpdateBoundsOfLpVariables() {
   }
 }
 
+bool LinearProgrammingConstraint::CallCutGenerators(int level) {
+  const int num_generators = cut_generators_.size();
+  std::vector<int> concurrent_generators;
+  if (parameters_.num_cut_generation_threads() > 1) {
+    for (int i = 0; i < num_generators; ++i) {
+      const CutGenerator& generator = cut_generators_[i];
+      if (level > 0 && generator.only_run_at_level_zero) continue;
+      if (generator.can_run_concurrently) concurrent_generators.push_back(i);
+    }
+  }
+
+  // The generators that can run concurrently always add their cuts to their
+  // own buffer, even when they run on the main thread. This way, the AddCut()
+  // results they observe only depend on the efficacy checks and not on the
+  // cuts already in constraint_manager_, which is only known in order.
+  cut_buffers_.resize(num_generators);
+  const auto get_buffer = [this](int i) {
+    if (cut_buffers_[i] == nullptr) {
+      cut_buffers_[i] = std::make_unique<LinearConstraintManager>(model_);
+      cut_buffers_[i]->EnableCutBuffering();
+    }
+    return cut_buffers_[i].get();
+  };
+
+  // The generators are only timed when the telemetry is enabled.
+  const bool collect_statistics = watcher_->StatisticsAreEnabled();
+
+  // We do not bother with the thread synchronization if there is only one.
+  std::vector<int> concurrent_results(num_generators, -1);
+  if (concurrent_generators.size() > 1) {
+    if (cut_generation_pool_ == nullptr) {
+      cut_generation_pool_ = std::make_unique<ThreadPool>(
+          "CutGeneration", parameters_.num_cut_generation_threads());
+      cut_generation_pool_->StartWorkers();
+    }
+    absl::BlockingCounter counter(concurrent_generators.size());
+    for (const int i : concurrent_generators) {
+      // The model random generator is not thread-safe, so we draw the seeds
+      // here, in generator order.
+      if (cut_generators_[i].set_random_seed != nullptr) {
+        cut_generators_[i].set_random_seed(absl::Uniform<uint64_t>(*random_));
+      }
+      LinearConstraintManager* buffer = get_buffer(i);
+      cut_generation_pool_->Schedule([this, i, buffer, collect_statistics,
+                                      &counter, &concurrent_results] {
+        const int64_t start_ns =
+            collect_statistics ? absl::GetCurrentTimeNanos() : 0;
+        const bool ok = cut_generators_[i].generate_cuts(buffer);
+        concurrent_results[i] = ok ? 1 : 0;
+        if (collect_statistics) {
+          cut_generator_time_ns_[i] += absl::GetCurrentTimeNanos() - start_ns;
+        }
+        ++cut_generator_num_calls_[i];
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+
+  for (int i = 0; i < num_generators; ++i) {
+    CutGenerator& generator = cut_generators_[i];
+    if (level > 0 && generator.only_run_at_level_zero) continue;
+    if (concurrent_results[i] == -1) {
+      LinearConstraintManager* manager = &constraint_manager_;
+      if (generator.can_run_concurrently) {
+        if (generator.set_random_seed != nullptr) {
+          generator.set_random_seed(std::nullopt);
+        }
+        manager = get_buffer(i);
+      }
+      const int64_t start_ns =
+          collect_statistics ? absl::GetCurrentTimeNanos() : 0;
+      const bool ok = generator.generate_cuts(manager);
+      if (collect_statistics) {
+        cut_generator_time_ns_[i] += absl::GetCurrentTimeNanos() - start_ns;
+      }
+      ++cut_generator_num_calls_[i];
+      if (manager != &constraint_manager_) {
+        manager->TransferBufferedCutsTo(&constraint_manager_);
+      }
+      if (!ok) return false;
+      continue;
+    }
+
+    cut_buffers_[i]->TransferBufferedCutsTo(&constraint_manager_);
+    if (concurrent_results[i] == 0) {
+      // Like in the sequential case, we ignore the cuts of the generators that
+      // come after the one that failed.
+      for (int j = i + 1; j < num_generators; ++j) {
+        if (concurrent_results[j] != -1) cut_buffers_[j] = nullptr;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
 bool LinearProgrammingConstraint::SolveLp() {
   const int level = trail_->CurrentDecisionLevel();
   if (level == 0) {
@@ -2192,12 +2382,7 @@ bool LinearProgrammingConstraint::Propagate() {
 
       // Try to add cuts.
       if (level == 0 || !parameters_.only_add_cuts_at_level_zero()) {
-        for (CutGenerator& generator : cut_generators_) {
-          if (level > 0 && generator.only_run_at_level_zero) continue;
-          if (!generator.generate_cuts(&constraint_manager_)) {
-            return false;
-          }
-        }
+        if (!CallCutGenerators(level)) return false;
       }
 
       implied_bounds_processor_.IbCutPool().TransferToManager(
@@ -2207,9 +2392,23 @@ bool LinearProgrammingConstraint::Propagate() {
     int num_added = 0;
     if (constraint_manager_.ChangeLp(&state_, &num_added)) {
       ++num_lp_changes_;
-      simplex_.LoadStateForNextSolve(state_);
-      if (!CreateLpFromConstraintManager()) {
-        return integer_trail_->ReportConflict({});
+
+      // If we only appended new constraints, we can keep the current scaling
+      // and basis, and the simplex will just extend its basis with the new
+      // slacks. We still redo everything from time to time as the scaling
+      // might become bad.
+      const int num_lp_rows = constraint_manager_.LpConstraints().size();
+      if (parameters_.add_lp_constraints_incrementally() && num_added > 0 &&
+          constraint_manager_.LastChangeOnlyAddedConstraints() &&
+          num_lp_rows <= 2 * num_rows_at_last_scaling_) {
+        if (!AddNewConstraintsFromConstraintManager()) {
+          return integer_trail_->ReportConflict({});
+        }
+      } else {
+        simplex_.LoadStateForNextSolve(state_);
+        if (!CreateLpFromConstraintManager()) {
+          return integer_trail_->ReportConflict({});
+        }
       }
 
       // If we didn't add any new constraint, we delay the next Solve() since
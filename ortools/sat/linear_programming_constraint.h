@@ -27,6 +27,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/revised_simplex.h"
 #include "ortools/glop/variables_info.h"
@@ -231,6 +232,20 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   int64_t num_bad_cuts() const { return num_bad_cuts_; }
   int64_t num_scaling_issues() const { return num_scaling_issues_; }
 
+  // Per cut generator stats. The time is the wall time spent in
+  // generate_cuts(), it is only measured once the statistics of the
+  // GenericLiteralWatcher are enabled.
+  int num_cut_generators() const { return cut_generators_.size(); }
+  const std::string& cut_generator_name(int i) const {
+    return cut_generators_[i].name;
+  }
+  int64_t cut_generator_num_calls(int i) const {
+    return cut_generator_num_calls_[i];
+  }
+  double cut_generator_time(int i) const {
+    return 1e-9 * static_cast<double>(cut_generator_time_ns_[i]);
+  }
+
   // This can serve as a timestamp to know if a saved basis is out of date.
   int64_t num_lp_changes() const { return num_lp_changes_; }
 
@@ -282,6 +297,30 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   // and some LP constraint are trivially false).
   bool CreateLpFromConstraintManager();
 
+  // Same as CreateLpFromConstraintManager() but only deals with the constraints
+  // that were appended to the LP of the constraint manager since the last call.
+  // The current column scaling is kept and only the new rows are scaled so that
+  // the simplex can warm-start from its current basis.
+  //
+  // Returns false if the problem is UNSAT.
+  bool AddNewConstraintsFromConstraintManager();
+
+  // Appends the given constraint to integer_lp_. Returns false if it is
+  // trivially infeasible.
+  bool AppendToIntegerLp(
+      const LinearConstraintManager::ConstraintInfo& constraint_info);
+
+  // Calls generate_cuts() on all the cut generators that should run at the
+  // given level. Returns false on conflict.
+  //
+  // The generators that can run concurrently always add their cuts to their
+  // own buffer, which are then transferred to the constraint manager in
+  // generator order. If num_cut_generation_threads > 1, they are first run in
+  // parallel, each with a random seed drawn from the model random generator,
+  // otherwise they run on the main thread with the model random generator. The
+  // result is thus deterministic for a given number of threads.
+  bool CallCutGenerators(int level);
+
   // Solve the LP, returns false if something went wrong in the LP solver.
   bool SolveLp();
 
@@ -429,6 +468,11 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   std::vector<double> col_max_;
   std::vector<double> col_min_;
 
+  // Number of LP rows when ComputeIntegerLpScalingFactors() was last called.
+  // We do a full rescale once too many rows were added incrementally since the
+  // column factors only depend on the rows present at that time.
+  int num_rows_at_last_scaling_ = 0;
+
   // This epsilon is related to the precision of the value/reduced_cost returned
   // by the LP once they have been scaled back into the CP domain. So for large
   // domain or cost coefficient, we may have some issues.
@@ -602,6 +646,14 @@ class LinearProgrammingConstraint : public PropagatorInterface,
 
   std::vector<CutGenerator> cut_generators_;
 
+  // See CallCutGenerators(). The buffers are indexed as cut_generators_ and
+  // are only created for the generators that can run concurrently, whatever
+  // the number of threads.
+  std::unique_ptr<ThreadPool> cut_generation_pool_;
+  std::vector<std::unique_ptr<LinearConstraintManager>> cut_buffers_;
+  std::vector<int64_t> cut_generator_num_calls_;
+  std::vector<int64_t> cut_generator_time_ns_;
+
   // Store some statistics for HeuristicLPReducedCostAverage().
   bool compute_reduced_cost_averages_ = false;
   int num_calls_since_reduced_cost_averages_reset_ = 0;
@@ -16,6 +16,7 @@
 #include <stdint.h>
 
 #include <cstdlib>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +26,7 @@
 #include "gtest/gtest.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/sat/cp_model_solver.h"
+#include "ortools/sat/cuts.h"
 #include "ortools/sat/integer.h"
 #include "ortools/sat/integer_base.h"
 #include "ortools/sat/integer_search.h"
@@ -302,6 +304,189 @@ TEST(LinearProgrammingConstraintTest, ReducedCostScalingColumns) {
   CHECK_LE(std::abs(reduced_costs[y] - 32), 1e-6);
 }
 
+struct CutGeneratorRun {
+  std::vector<bool> add_cut_results;
+  std::vector<std::optional<uint64_t>> seeds;
+};
+
+// Solves min -x - y s.t. x + y <= 15, x, y in [0, 10] with two cut generators
+// that can run concurrently and that add the same cut, or an update of it.
+// Returns what each generator observed and the final constraints.
+std::vector<std::string> SolveWithDuplicateCuts(
+    int num_threads, std::vector<CutGeneratorRun>* runs) {
+  Model m;
+  SatParameters* params = m.GetOrCreate<SatParameters>();
+  params->set_add_lp_constraints_lazily(false);
+  params->set_add_objective_cut(false);
+  params->set_add_mir_cuts(false);
+  params->set_add_cg_cuts(false);
+  params->set_add_zero_half_cuts(false);
+  params->set_num_cut_generation_threads(num_threads);
+
+  const IntegerVariable x = m.Add(NewIntegerVariable(0, 10));
+  const IntegerVariable y = m.Add(NewIntegerVariable(0, 10));
+  LinearProgrammingConstraint* lp = new LinearProgrammingConstraint(&m, {x, y});
+  m.TakeOwnership(lp);
+
+  LinearConstraintBuilder ct(IntegerValue(0), IntegerValue(15));
+  ct.AddTerm(x, IntegerValue(1));
+  ct.AddTerm(y, IntegerValue(1));
+  lp->AddLinearConstraint(ct.Build());
+
+  const IntegerVariable obj = m.Add(NewIntegerVariable(-20, 0));
+  lp->SetObjectiveCoefficient(x, IntegerValue(-1));
+  lp->SetObjectiveCoefficient(y, IntegerValue(-1));
+  lp->SetMainObjectiveVariable(obj);
+
+  const auto sum_at_most = [x, y](int64_t ub) {
+    LinearConstraintBuilder cut(kMinIntegerValue, IntegerValue(ub));
+    cut.AddTerm(x, IntegerValue(1));
+    cut.AddTerm(y, IntegerValue(1));
+    return cut.Build();
+  };
+  runs->assign(2, CutGeneratorRun());
+  for (int g = 0; g < 2; ++g) {
+    CutGeneratorRun* run = &(*runs)[g];
+    CutGenerator generator;
+    generator.can_run_concurrently = true;
+    generator.vars = {x, y};
+    generator.set_random_seed = [run](std::optional<uint64_t> seed) {
+      run->seeds.push_back(seed);
+    };
+    generator.generate_cuts = [run, g,
+                               sum_at_most](LinearConstraintManager* manager) {
+      run->add_cut_results.push_back(manager->AddCut(sum_at_most(14), "Test"));
+      run->add_cut_results.push_back(
+          manager->AddCut(sum_at_most(g == 0 ? 14 : 13), "Test"));
+      return true;
+    };
+    lp->AddCutGenerator(std::move(generator));
+  }
+
+  lp->RegisterWith(&m);
+  EXPECT_TRUE(lp->Propagate());
+
+  std::vector<std::string> constraints;
+  for (const auto& info : lp->constraint_manager().AllConstraints()) {
+    constraints.push_back(info.constraint.DebugString());
+  }
+  return constraints;
+}
+
+TEST(LinearProgrammingConstraintTest,
+     ConcurrentCutGeneratorsSameAsSingleThread) {
+  std::vector<CutGeneratorRun> sequential_runs;
+  const std::vector<std::string> sequential_constraints =
+      SolveWithDuplicateCuts(/*num_threads=*/1, &sequential_runs);
+  std::vector<CutGeneratorRun> concurrent_runs;
+  const std::vector<std::string> concurrent_constraints =
+      SolveWithDuplicateCuts(/*num_threads=*/4, &concurrent_runs);
+
+  EXPECT_EQ(sequential_constraints, concurrent_constraints);
+  for (int g = 0; g < 2; ++g) {
+    // The generators only see the result of the efficacy checks, not whether
+    // the cut was a duplicate of one added by another generator.
+    ASSERT_FALSE(sequential_runs[g].add_cut_results.empty());
+    EXPECT_EQ(sequential_runs[g].add_cut_results,
+              concurrent_runs[g].add_cut_results);
+
+    // Only the concurrent runs get their own seed.
+    EXPECT_EQ(sequential_runs[g].seeds.size(),
+              sequential_runs[g].add_cut_results.size() / 2);
+    for (const std::optional<uint64_t>& seed : sequential_runs[g].seeds) {
+      EXPECT_FALSE(seed.has_value());
+    }
+    for (const std::optional<uint64_t>& seed : concurrent_runs[g].seeds) {
+      EXPECT_TRUE(seed.has_value());
+    }
+  }
+}
+
+struct CutRoundsResult {
+  double objective_lp_lower_bound;
+  std::vector<IntegerValue> lower_bounds;
+  std::vector<IntegerValue> upper_bounds;
+};
+
+// Solves max 7x + 3y + 2z s.t. x + y + z <= 20, x, y, z in [0, 10], with a
+// cut generator that needs several rounds to add all of its cuts, since each
+// of them is only violated once the previous ones are in the LP. The optimum
+// is then x = 10, y = 5, z = 2.
+CutRoundsResult SolveWithSeveralCutRounds(bool add_incrementally) {
+  Model m;
+  SatParameters* params = m.GetOrCreate<SatParameters>();
+  params->set_add_lp_constraints_lazily(false);
+  params->set_add_lp_constraints_incrementally(add_incrementally);
+  params->set_max_cut_rounds_at_level_zero(5);
+  params->set_add_objective_cut(false);
+  params->set_add_mir_cuts(false);
+  params->set_add_cg_cuts(false);
+  params->set_add_zero_half_cuts(false);
+
+  const IntegerVariable x = m.Add(NewIntegerVariable(0, 10));
+  const IntegerVariable y = m.Add(NewIntegerVariable(0, 10));
+  const IntegerVariable z = m.Add(NewIntegerVariable(0, 10));
+  LinearProgrammingConstraint* lp =
+      new LinearProgrammingConstraint(&m, {x, y, z});
+  m.TakeOwnership(lp);
+
+  LinearConstraintBuilder ct(IntegerValue(0), IntegerValue(20));
+  ct.AddTerm(x, IntegerValue(1));
+  ct.AddTerm(y, IntegerValue(1));
+  ct.AddTerm(z, IntegerValue(1));
+  lp->AddLinearConstraint(ct.Build());
+
+  const IntegerVariable obj = m.Add(NewIntegerVariable(-200, 0));
+  lp->SetObjectiveCoefficient(x, IntegerValue(-7));
+  lp->SetObjectiveCoefficient(y, IntegerValue(-3));
+  lp->SetObjectiveCoefficient(z, IntegerValue(-2));
+  lp->SetMainObjectiveVariable(obj);
+
+  CutGenerator generator;
+  generator.vars = {x, y, z};
+  generator.generate_cuts = [x, y, z](LinearConstraintManager* manager) {
+    // Cuts that are not violated by the current LP solution are ignored.
+    const std::vector<std::pair<std::vector<int64_t>, int64_t>> cuts = {
+        {{1, 1, 0}, 15}, {{1, 0, 1}, 14}, {{2, 1, 1}, 27}};
+    for (const auto& [coeffs, ub] : cuts) {
+      LinearConstraintBuilder cut(kMinIntegerValue, IntegerValue(ub));
+      cut.AddTerm(x, IntegerValue(coeffs[0]));
+      cut.AddTerm(y, IntegerValue(coeffs[1]));
+      cut.AddTerm(z, IntegerValue(coeffs[2]));
+      manager->AddCut(cut.Build(), "Test");
+    }
+    return true;
+  };
+  lp->AddCutGenerator(std::move(generator));
+
+  lp->RegisterWith(&m);
+  EXPECT_TRUE(lp->Propagate());
+
+  CutRoundsResult result;
+  result.objective_lp_lower_bound = lp->ObjectiveLpLowerBound();
+  const IntegerTrail& integer_trail = *m.GetOrCreate<IntegerTrail>();
+  for (const IntegerVariable var : {x, y, z, obj}) {
+    result.lower_bounds.push_back(integer_trail.LowerBound(var));
+    result.upper_bounds.push_back(integer_trail.UpperBound(var));
+  }
+  EXPECT_EQ(lp->constraint_manager().num_cuts(), 3);
+  return result;
+}
+
+TEST(LinearProgrammingConstraintTest, IncrementalCutRoundsSameAsFullReload) {
+  const CutRoundsResult incremental =
+      SolveWithSeveralCutRounds(/*add_incrementally=*/true);
+  const CutRoundsResult full = SolveWithSeveralCutRounds(
+      /*add_incrementally=*/false);
+
+  EXPECT_NEAR(incremental.objective_lp_lower_bound, -89.0, 1e-6);
+  EXPECT_NEAR(incremental.objective_lp_lower_bound,
+              full.objective_lp_lower_bound, 1e-6);
+  EXPECT_EQ(incremental.lower_bounds, full.lower_bounds);
+  EXPECT_EQ(incremental.upper_bounds, full.upper_bounds);
+  EXPECT_EQ(incremental.lower_bounds.back(), -89);
+}
+
 }  // namespace
 }  // namespace sat
 }  // namespace operations_research
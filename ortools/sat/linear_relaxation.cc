@@ -1882,8 +1882,14 @@ LinearRelaxation ComputeLinearRelaxation(const CpModelProto& model_proto,
 
   // Linearize the constraints.
   for (const auto& ct : model_proto.constraints()) {
+    const int old_num_generators = relaxation.cut_generators.size();
     TryToLinearizeConstraint(model_proto, ct, params.linearization_level(), m,
                              &relaxation, &activity_bound_helper);
+    for (int i = old_num_generators; i < relaxation.cut_generators.size();
+         ++i) {
+      relaxation.cut_generators[i].name =
+          ConstraintCaseName(ct.constraint_case());
+    }
   }
 
   // Linearize the encoding of variable that are fully encoded.
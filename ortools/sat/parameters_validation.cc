@@ -110,6 +110,9 @@ std::string ValidateParameters(const SatParameters& params) {
   TEST_IN_RANGE(num_search_workers, 0, kMaxReasonableParallelism);
   TEST_IN_RANGE(shared_tree_num_workers, -1, kMaxReasonableParallelism);
   TEST_IN_RANGE(interleave_batch_size, 0, kMaxReasonableParallelism);
+  TEST_IN_RANGE(num_cut_generation_threads, 1, kMaxReasonableParallelism);
+  TEST_IN_RANGE(num_probing_threads, 1, kMaxReasonableParallelism);
+  TEST_IN_RANGE(num_inprocessing_threads, 1, kMaxReasonableParallelism);
   TEST_IN_RANGE(shared_tree_open_leaves_per_worker, 1,
                 kMaxReasonableParallelism);
   TEST_IN_RANGE(shared_tree_balance_tolerance, 0,
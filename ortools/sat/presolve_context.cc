@@ -2503,7 +2503,11 @@ bool LoadModelForPresolve(const CpModelProto& model_proto, SatParameters params,
   *local_model->GetOrCreate<SatParameters>() = std::move(params);
   local_model->GetOrCreate<TimeLimit>()->MergeWithGlobalTimeLimit(
       context->time_limit());
-  local_model->Register<ModelRandomGenerator>(context->random());
+  // The caller can register its own generator, for instance when the local
+  // model is used from another thread.
+  if (local_model->Get<ModelRandomGenerator>() == nullptr) {
+    local_model->Register<ModelRandomGenerator>(context->random());
+  }
   auto* encoder = local_model->GetOrCreate<IntegerEncoder>();
   encoder->DisableImplicationBetweenLiteral();
   auto* mapping = local_model->GetOrCreate<CpModelMapping>();
@@ -20,6 +20,7 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -30,6 +31,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
+#include "absl/random/bit_gen_ref.h"
 #include "absl/random/distributions.h"
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
@@ -47,6 +49,7 @@
 #include "ortools/sat/precedences.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/util.h"
+#include "ortools/util/random_engine.h"
 #include "ortools/util/strong_integers.h"
 
 namespace operations_research {
@@ -400,7 +403,8 @@ class OutgoingCutHelper {
         literal_lp_values_(literals.size()),
         params_(*model->GetOrCreate<SatParameters>()),
         trail_(*model->GetOrCreate<Trail>()),
-        random_(model->GetOrCreate<ModelRandomGenerator>()),
+        model_random_(model->GetOrCreate<ModelRandomGenerator>()),
+        random_(*model_random_),
         encoder_(model->GetOrCreate<IntegerEncoder>()),
         in_subset_(num_nodes, false),
         min_outgoing_flow_helper_(num_nodes, tails_, heads_, literals_, model) {
@@ -412,6 +416,18 @@ class OutgoingCutHelper {
 
   int num_nodes() const { return num_nodes_; }
 
+  // See CutGenerator::set_random_seed. When running on a cut generation
+  // thread, we must not touch the model random generator, so we use our own
+  // engine seeded by the caller instead.
+  void SetRandomSeed(std::optional<uint64_t> seed) {
+    if (seed.has_value()) {
+      concurrent_random_.seed(*seed);
+      random_ = absl::BitGenRef(concurrent_random_);
+    } else {
+      random_ = *model_random_;
+    }
+  }
+
   bool is_route_constraint() const { return is_route_constraint_; }
 
   // Returns the arcs computed by InitializeForNewLpSolution().
@@ -486,7 +502,9 @@ class OutgoingCutHelper {
 
   const SatParameters& params_;
   const Trail& trail_;
-  ModelRandomGenerator* random_;
+  ModelRandomGenerator* model_random_;
+  random_engine_t concurrent_random_;
+  absl::BitGenRef random_;
   IntegerEncoder* encoder_;
 
   int64_t total_demand_ = 0;
@@ -849,7 +867,7 @@ bool OutgoingCutHelper::TrySubsetCut(std::string name,
     ignore_arcs_with_head =
         bests.size() == 1
             ? bests[0]
-            : bests[absl::Uniform<int>(*random_, 0, bests.size())];
+            : bests[absl::Uniform<int>(random_, 0, bests.size())];
   }
 
   // Compute the current outgoing flow out of the subset.
@@ -1323,7 +1341,11 @@ CutGenerator CreateStronglyConnectedGraphCutGenerator(
       num_nodes, /*is_route_constraint=*/false, /*capacity=*/0,
       /*demands=*/absl::Span<const int64_t>(), tails, heads, literals, model);
   CutGenerator result;
+  result.can_run_concurrently = true;
   result.vars = GetAssociatedVariables(literals, model);
+  result.set_random_seed = [helper = helper.get()](std::optional<uint64_t> s) {
+    helper->SetRandomSeed(s);
+  };
   result.generate_cuts =
       [helper = std::move(helper)](LinearConstraintManager* manager) {
         SeparateSubtourInequalities(*helper, manager);
@@ -1341,7 +1363,11 @@ CutGenerator CreateCVRPCutGenerator(int num_nodes, absl::Span<const int> tails,
       num_nodes, /*is_route_constraint=*/true, capacity, demands, tails, heads,
       literals, model);
   CutGenerator result;
+  result.can_run_concurrently = true;
   result.vars = GetAssociatedVariables(literals, model);
+  result.set_random_seed = [helper = helper.get()](std::optional<uint64_t> s) {
+    helper->SetRandomSeed(s);
+  };
   result.generate_cuts =
       [helper = std::move(helper)](LinearConstraintManager* manager) {
         SeparateSubtourInequalities(*helper, manager);
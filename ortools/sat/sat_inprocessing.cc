@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <deque>
 #include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -25,10 +26,12 @@
 #include "absl/cleanup/cleanup.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/timer.h"
 #include "ortools/sat/clause.h"
 #include "ortools/sat/drat_checker.h"
@@ -472,9 +475,7 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
       clauses.begin(), clauses.end(),
       [](SatClause* a, SatClause* b) { return a->size() < b->size(); });
 
-  // Used to mark clause literals.
   const LiteralIndex num_literals(sat_solver_->NumVariables() * 2);
-  SparseBitset<LiteralIndex> marked(num_literals);
 
   // Clause index in clauses.
   // TODO(user): Storing signatures here might be faster?
@@ -484,17 +485,21 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
   // Clause signatures in the same order as clauses.
   std::vector<uint64_t> signatures(clauses.size());
 
-  std::vector<Literal> candidates_for_removal;
-  for (int clause_index = 0; clause_index < clauses.size(); ++clause_index) {
-    SatClause* clause = clauses[clause_index];
-
-    // TODO(user): Better abort limit. We could also limit the watcher sizes and
-    // never look at really long clauses. Note that for an easier
-    // incrementality, it is better to reach some kind of completion so we know
-    // what new stuff need to be done.
-    if (num_inspected_literals + num_inspected_signatures > 1e9) {
-      break;
-    }
+  // Looks for a clause registered in one_watcher that subsumes the given one,
+  // or that can be used to remove one of its literals. This only reads the
+  // shared data structures, so it can be called concurrently on different
+  // clauses as long as one_watcher is not modified.
+  struct ClauseReduction {
+    bool subsumed = false;
+    // The first literal we found that can be removed, if any.
+    LiteralIndex to_remove = kNoLiteralIndex;
+    int64_t num_inspected_signatures = 0;
+    int64_t num_inspected_literals = 0;
+  };
+  const auto find_reduction = [&one_watcher, &signatures, &clauses](
+                                  const SatClause* clause,
+                                  SparseBitset<LiteralIndex>* marked) {
+    ClauseReduction result;
 
     // Check for subsumption, note that this currently ignore all clauses in the
     // binary implication graphs. Stamping is doing some of that (and some also
@@ -508,31 +513,29 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
 
     // Compute hash and mark literals.
     uint64_t signature = 0;
-    marked.SparseClearAll();
+    marked->SparseClearAll();
     for (const Literal l : clause->AsSpan()) {
-      marked.Set(l.Index());
+      marked->Set(l.Index());
       signature |= (uint64_t{1} << (l.Variable().value() % 64));
     }
 
     // Look for clause that subsumes this one. Note that because we inspect
     // all one watcher lists for the literals of this clause, if a clause is
     // included inside this one, it must appear in one of these lists.
-    bool removed = false;
-    candidates_for_removal.clear();
     const uint64_t mask = ~signature;
     for (const Literal l : clause->AsSpan()) {
-      num_inspected_signatures += one_watcher[l].size();
+      result.num_inspected_signatures += one_watcher[l].size();
       for (const int i : one_watcher[l]) {
         if ((mask & signatures[i]) != 0) continue;
 
         bool subsumed = true;
         bool stengthen = true;
         LiteralIndex to_remove = kNoLiteralIndex;
-        num_inspected_literals += clauses[i]->size();
+        result.num_inspected_literals += clauses[i]->size();
         for (const Literal o : clauses[i]->AsSpan()) {
-          if (!marked[o]) {
+          if (!(*marked)[o]) {
             subsumed = false;
-            if (to_remove == kNoLiteralIndex && marked[o.NegatedIndex()]) {
+            if (to_remove == kNoLiteralIndex && (*marked)[o.NegatedIndex()]) {
               to_remove = o.NegatedIndex();
             } else {
               stengthen = false;
@@ -541,100 +544,160 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
           }
         }
         if (subsumed) {
-          ++num_subsumed_clauses;
-          num_removed_literals += clause->size();
-          clause_manager_->InprocessingRemoveClause(clause);
-          removed = true;
-          break;
+          result.subsumed = true;
+          return result;
         }
         if (stengthen) {
           CHECK_NE(kNoLiteralIndex, to_remove);
-          candidates_for_removal.push_back(Literal(to_remove));
+          if (result.to_remove == kNoLiteralIndex) result.to_remove = to_remove;
         }
       }
-      if (removed) break;
     }
-    if (removed) continue;
 
     // For strengthenning we also need to check the negative watcher lists.
     for (const Literal l : clause->AsSpan()) {
-      num_inspected_signatures += one_watcher[l.NegatedIndex()].size();
+      result.num_inspected_signatures += one_watcher[l.NegatedIndex()].size();
       for (const int i : one_watcher[l.NegatedIndex()]) {
         if ((mask & signatures[i]) != 0) continue;
 
         bool stengthen = true;
-        num_inspected_literals += clauses[i]->size();
+        result.num_inspected_literals += clauses[i]->size();
         for (const Literal o : clauses[i]->AsSpan()) {
           if (o == l.Negated()) continue;
-          if (!marked[o]) {
+          if (!(*marked)[o]) {
             stengthen = false;
             break;
           }
         }
-        if (stengthen) {
-          candidates_for_removal.push_back(l);
+        if (stengthen && result.to_remove == kNoLiteralIndex) {
+          result.to_remove = l.Index();
         }
       }
     }
+    return result;
+  };
 
-    // Any literal here can be removed, but afterwards the other might not. For
-    // now we just remove the first one.
-    //
-    // TODO(user): remove first and see if other still removable. Alternatively
-    // use a "removed" marker and redo a check for each clause that simplifies
-    // this one? Or just remove the first one, and wait for next round.
-    if (!candidates_for_removal.empty()) {
-      new_clause.clear();
-      for (const Literal l : clause->AsSpan()) {
-        if (l == candidates_for_removal[0]) continue;
-        new_clause.push_back(l);
-      }
-      CHECK_EQ(new_clause.size() + 1, clause->size());
+  // With more than one thread, we look for the reductions of a batch of
+  // clauses in parallel, and then apply them in order. Only the clauses of the
+  // previous batches are registered in one_watcher, so a clause cannot be
+  // reduced by another clause of the same batch. The result only depends on
+  // the batch size, not on the thread scheduling. A batch size of one gives
+  // back the sequential algorithm.
+  const int num_threads = params_.num_inprocessing_threads();
+  const int batch_size = num_threads > 1 ? 64 * num_threads : 1;
+  std::unique_ptr<ThreadPool> pool;
+  if (num_threads > 1) {
+    pool = std::make_unique<ThreadPool>("Subsumption", num_threads);
+    pool->StartWorkers();
+  }
+  std::vector<SparseBitset<LiteralIndex>> marked(num_threads);
+  for (SparseBitset<LiteralIndex>& bitset : marked) {
+    bitset.ClearAndResize(num_literals);
+  }
+  std::vector<ClauseReduction> reductions(batch_size);
 
-      num_removed_literals += clause->size() - new_clause.size();
-      if (!clause_manager_->InprocessingRewriteClause(clause, new_clause)) {
-        return false;
-      }
-      if (clause->size() == 0) continue;
+  for (int batch_start = 0; batch_start < clauses.size();
+       batch_start += batch_size) {
+    // TODO(user): Better abort limit. We could also limit the watcher sizes and
+    // never look at really long clauses. Note that for an easier
+    // incrementality, it is better to reach some kind of completion so we know
+    // what new stuff need to be done.
+    if (num_inspected_literals + num_inspected_signatures > 1e9) {
+      break;
+    }
 
-      // Recompute signature.
-      signature = 0;
-      for (const Literal l : clause->AsSpan()) {
-        signature |= (uint64_t{1} << (l.Variable().value() % 64));
+    const int batch_end =
+        std::min<int>(batch_start + batch_size, clauses.size());
+    if (pool == nullptr) {
+      for (int index = batch_start; index < batch_end; ++index) {
+        reductions[index - batch_start] =
+            find_reduction(clauses[index], &marked[0]);
       }
+    } else {
+      absl::BlockingCounter counter(num_threads);
+      for (int t = 0; t < num_threads; ++t) {
+        pool->Schedule([&, t]() {
+          for (int index = batch_start + t; index < batch_end;
+               index += num_threads) {
+            reductions[index - batch_start] =
+                find_reduction(clauses[index], &marked[t]);
+          }
+          counter.DecrementCount();
+        });
+      }
+      counter.Wait();
     }
 
-    // Register one literal to watch. Any literal works, but we choose the
-    // smallest list.
-    //
-    // TODO(user): No need to add this clause if we know it cannot subsume
-    // any new clause since last round. i.e. unchanged clause that do not
-    // contains any literals of newly added clause do not need to be added
-    // here. We can track two bitset in LiteralWatchers via a register
-    // mechanism:
-    // - literal of newly watched clauses since last clear.
-    // - literal of reduced clauses since last clear.
-    //
-    // Important: we can only use this clause to subsume/strenghten others if
-    // it cannot be deleted later.
-    if (!clause_manager_->IsRemovable(clause)) {
-      int min_size = std::numeric_limits<int32_t>::max();
-      LiteralIndex min_literal = kNoLiteralIndex;
-      for (const Literal l : clause->AsSpan()) {
-        if (one_watcher[l].size() < min_size) {
-          min_size = one_watcher[l].size();
-          min_literal = l.Index();
+    for (int clause_index = batch_start; clause_index < batch_end;
+         ++clause_index) {
+      SatClause* clause = clauses[clause_index];
+      const ClauseReduction& reduction = reductions[clause_index - batch_start];
+      num_inspected_signatures += reduction.num_inspected_signatures;
+      num_inspected_literals += reduction.num_inspected_literals;
+      if (reduction.subsumed) {
+        ++num_subsumed_clauses;
+        num_removed_literals += clause->size();
+        clause_manager_->InprocessingRemoveClause(clause);
+        continue;
+      }
+
+      // Any literal found can be removed, but afterwards the other might not.
+      // For now we just remove the first one.
+      //
+      // TODO(user): remove first and see if other still removable.
+      // Alternatively use a "removed" marker and redo a check for each clause
+      // that simplifies this one? Or just remove the first one, and wait for
+      // next round.
+      if (reduction.to_remove != kNoLiteralIndex) {
+        new_clause.clear();
+        for (const Literal l : clause->AsSpan()) {
+          if (l.Index() == reduction.to_remove) continue;
+          new_clause.push_back(l);
+        }
+        CHECK_EQ(new_clause.size() + 1, clause->size());
+
+        num_removed_literals += clause->size() - new_clause.size();
+        if (!clause_manager_->InprocessingRewriteClause(clause, new_clause)) {
+          return false;
         }
+        if (clause->size() == 0) continue;
       }
 
-      // TODO(user): We could/should sort the literal in this clause by
-      // using literals that appear in a small number of clauses first so that
-      // we maximize the chance of early abort in the critical loops above.
+      // Register one literal to watch. Any literal works, but we choose the
+      // smallest list.
+      //
+      // TODO(user): No need to add this clause if we know it cannot subsume
+      // any new clause since last round. i.e. unchanged clause that do not
+      // contains any literals of newly added clause do not need to be added
+      // here. We can track two bitset in LiteralWatchers via a register
+      // mechanism:
+      // - literal of newly watched clauses since last clear.
+      // - literal of reduced clauses since last clear.
       //
-      // TODO(user): We could also move the watched literal first so we always
-      // skip it.
-      signatures[clause_index] = signature;
-      one_watcher[min_literal].push_back(clause_index);
+      // Important: we can only use this clause to subsume/strenghten others if
+      // it cannot be deleted later.
+      if (!clause_manager_->IsRemovable(clause)) {
+        uint64_t signature = 0;
+        int min_size = std::numeric_limits<int32_t>::max();
+        LiteralIndex min_literal = kNoLiteralIndex;
+        for (const Literal l : clause->AsSpan()) {
+          signature |= (uint64_t{1} << (l.Variable().value() % 64));
+          if (one_watcher[l].size() < min_size) {
+            min_size = one_watcher[l].size();
+            min_literal = l.Index();
+          }
+        }
+
+        // TODO(user): We could/should sort the literal in this clause by
+        // using literals that appear in a small number of clauses first so
+        // that we maximize the chance of early abort in the critical loops
+        // above.
+        //
+        // TODO(user): We could also move the watched literal first so we
+        // always skip it.
+        signatures[clause_index] = signature;
+        one_watcher[min_literal].push_back(clause_index);
+      }
     }
   }
 
@@ -23,6 +23,7 @@
 #include "ortools/sat/clause.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
+#include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
 
 namespace operations_research {
@@ -164,6 +165,31 @@ TEST(InprocessingTest, ClauseSubsumptionAndStrengthening) {
   }
 }
 
+TEST(InprocessingTest, ParallelClauseSubsumptionAndStrengthening) {
+  Model model;
+  model.GetOrCreate<SatParameters>()->set_num_inprocessing_threads(2);
+  auto* sat_solver = model.GetOrCreate<SatSolver>();
+  auto* clause_manager = model.GetOrCreate<ClauseManager>();
+  auto* inprocessing = model.GetOrCreate<Inprocessing>();
+
+  // Enough independent clauses so that the larger ones below are not in the
+  // same batch as the one that reduce them.
+  const int num_small_clauses = 300;
+  sat_solver->SetNumVariables(3 * num_small_clauses + 10);
+  for (int i = 0; i < num_small_clauses; ++i) {
+    EXPECT_TRUE(clause_manager->AddClause(
+        Literals({3 * i + 1, 3 * i + 2, 3 * i + 3})));
+  }
+  const int x = 3 * num_small_clauses + 1;
+  EXPECT_TRUE(clause_manager->AddClause(Literals({+1, +2, +3, x})));
+  EXPECT_TRUE(clause_manager->AddClause(Literals({+4, +5, -6, x, x + 1})));
+
+  EXPECT_TRUE(inprocessing->SubsumeAndStrenghtenRound(/*log_info=*/false));
+  const auto& all_clauses = clause_manager->AllClausesInCreationOrder();
+  ASSERT_EQ(all_clauses.size(), num_small_clauses + 1);
+  EXPECT_EQ(all_clauses.back()->AsSpan(), Literals({+4, +5, x, x + 1}));
+}
+
 TEST(StampingSimplifierTest, StampConstruction) {
   Model model;
   auto* sat_solver = model.GetOrCreate<SatSolver>();
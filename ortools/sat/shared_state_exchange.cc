@@ -0,0 +1,245 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/shared_state_exchange.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "ortools/base/logging.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_utils.h"
+#include "ortools/sat/integer_base.h"
+#include "ortools/sat/shared_state.pb.h"
+#include "ortools/sat/synchronization.h"
+
+namespace operations_research {
+namespace sat {
+
+class LoopbackSharedStateHub::Endpoint : public SharedStateTransport {
+ public:
+  Endpoint(LoopbackSharedStateHub* hub, int index) : hub_(hub), index_(index) {}
+
+  void Send(const SharedStateUpdate& update) final {
+    hub_->Broadcast(index_, update);
+  }
+
+  std::vector<SharedStateUpdate> Receive() final {
+    return hub_->PopAll(index_);
+  }
+
+ private:
+  LoopbackSharedStateHub* hub_;
+  const int index_;
+};
+
+LoopbackSharedStateHub::LoopbackSharedStateHub() = default;
+LoopbackSharedStateHub::~LoopbackSharedStateHub() = default;
+
+SharedStateTransport* LoopbackSharedStateHub::NewEndpoint() {
+  absl::MutexLock mutex_lock(&mutex_);
+  const int index = endpoints_.size();
+  endpoints_.push_back(std::make_unique<Endpoint>(this, index));
+  inboxes_.emplace_back();
+  return endpoints_.back().get();
+}
+
+void LoopbackSharedStateHub::Broadcast(int sender,
+                                       const SharedStateUpdate& update) {
+  absl::MutexLock mutex_lock(&mutex_);
+  for (int i = 0; i < inboxes_.size(); ++i) {
+    if (i == sender) continue;
+    inboxes_[i].push_back(update);
+  }
+}
+
+std::vector<SharedStateUpdate> LoopbackSharedStateHub::PopAll(int receiver) {
+  absl::MutexLock mutex_lock(&mutex_);
+  std::vector<SharedStateUpdate> result(
+      std::make_move_iterator(inboxes_[receiver].begin()),
+      std::make_move_iterator(inboxes_[receiver].end()));
+  inboxes_[receiver].clear();
+  return result;
+}
+
+SharedStateExchanger::SharedStateExchanger(absl::string_view name,
+                                           const CpModelProto& model_proto,
+                                           SharedStateTransport* transport,
+                                           SharedResponseManager* response,
+                                           SharedBoundsManager* bounds,
+                                           SharedClausesManager* clauses)
+    : name_(name),
+      model_fingerprint_(FingerprintModel(model_proto)),
+      has_objective_(model_proto.has_objective() &&
+                     !model_proto.objective().vars().empty()),
+      num_variables_(model_proto.variables().size()),
+      transport_(transport),
+      response_(response),
+      bounds_(bounds),
+      clauses_(clauses) {
+  if (bounds_ != nullptr) bounds_id_ = bounds_->RegisterNewId();
+  if (clauses_ != nullptr) {
+    clauses_id_ = clauses_->RegisterNewId();
+    clauses_->SetWorkerNameForId(clauses_id_, name_);
+  }
+}
+
+void SharedStateExchanger::Synchronize() {
+  SharedStateUpdate update;
+  if (FillUpdate(&update)) {
+    ++num_sent_;
+    transport_->Send(update);
+  }
+  for (const SharedStateUpdate& received : transport_->Receive()) {
+    if (received.model_fingerprint() != model_fingerprint_) {
+      VLOG(1) << "Ignoring shared state from '" << received.sender_name()
+              << "' which is solving a different model.";
+      continue;
+    }
+    ++num_imported_;
+    Import(received);
+  }
+}
+
+bool SharedStateExchanger::FillUpdate(SharedStateUpdate* update) {
+  bool has_something = false;
+  update->set_model_fingerprint(model_fingerprint_);
+  update->set_sender_name(name_);
+
+  const SharedSolutionRepository<int64_t>& repo =
+      response_->SolutionsRepository();
+  if (repo.NumSolutions() > 0) {
+    const auto solution = repo.GetSolution(0);
+    if (!solution_shared_ || solution->rank < best_shared_rank_) {
+      solution_shared_ = true;
+      best_shared_rank_ = solution->rank;
+      update->mutable_solution()->Assign(solution->variable_values.begin(),
+                                         solution->variable_values.end());
+      has_something = true;
+    }
+  }
+
+  if (has_objective_) {
+    const int64_t lb = response_->GetInnerObjectiveLowerBound().value();
+    const int64_t ub = response_->GetInnerObjectiveUpperBound().value();
+    if (lb > shared_lower_bound_ || ub < shared_upper_bound_) {
+      shared_lower_bound_ = std::max(shared_lower_bound_, lb);
+      shared_upper_bound_ = std::min(shared_upper_bound_, ub);
+      update->set_has_objective_bounds(true);
+      update->set_inner_objective_lower_bound(lb);
+      update->set_inner_objective_upper_bound(ub);
+      has_something = true;
+    }
+  }
+
+  if (bounds_ != nullptr) {
+    bounds_->GetChangedBounds(bounds_id_, &tmp_variables_, &tmp_lower_bounds_,
+                              &tmp_upper_bounds_);
+    if (!tmp_variables_.empty()) {
+      update->mutable_bound_variables()->Assign(tmp_variables_.begin(),
+                                                tmp_variables_.end());
+      update->mutable_bound_lower_bounds()->Assign(tmp_lower_bounds_.begin(),
+                                                   tmp_lower_bounds_.end());
+      update->mutable_bound_upper_bounds()->Assign(tmp_upper_bounds_.begin(),
+                                                   tmp_upper_bounds_.end());
+      has_something = true;
+    }
+  }
+
+  if (clauses_ != nullptr) {
+    clauses_->GetUnseenBinaryClauses(clauses_id_, &tmp_binary_clauses_);
+    for (const auto [a, b] : tmp_binary_clauses_) {
+      if (imported_binary_clauses_.contains({a, b})) continue;
+      update->add_binary_clause_literals(a);
+      update->add_binary_clause_literals(b);
+      has_something = true;
+    }
+    for (const absl::Span<const int> clause :
+         clauses_->GetUnseenClauses(clauses_id_)) {
+      update->mutable_clause_literals()->Add(clause.begin(), clause.end());
+      update->add_clause_sizes(clause.size());
+      has_something = true;
+    }
+  }
+  return has_something;
+}
+
+void SharedStateExchanger::Import(const SharedStateUpdate& update) {
+  const std::string info = absl::StrCat("remote_", update.sender_name());
+  const auto is_valid_literal = [this](int lit) {
+    return PositiveRef(lit) < num_variables_;
+  };
+
+  if (update.solution_size() == num_variables_) {
+    const auto solution = response_->NewSolution(update.solution(), info);
+    if (solution != nullptr) {
+      solution_shared_ = true;
+      best_shared_rank_ = std::min(best_shared_rank_, solution->rank);
+    }
+  }
+
+  if (has_objective_ && update.has_objective_bounds()) {
+    const int64_t lb = update.inner_objective_lower_bound();
+    const int64_t ub = update.inner_objective_upper_bound();
+    shared_lower_bound_ = std::max(shared_lower_bound_, lb);
+    shared_upper_bound_ = std::min(shared_upper_bound_, ub);
+    response_->UpdateInnerObjectiveBounds(info, IntegerValue(lb),
+                                          IntegerValue(ub));
+  }
+
+  const int num_bounds = update.bound_variables_size();
+  if (bounds_ != nullptr && num_bounds > 0 &&
+      update.bound_lower_bounds_size() == num_bounds &&
+      update.bound_upper_bounds_size() == num_bounds &&
+      absl::c_all_of(update.bound_variables(), [this](int var) {
+        return var >= 0 && var < num_variables_;
+      })) {
+    bounds_->ReportPotentialNewBounds(info, update.bound_variables(),
+                                      update.bound_lower_bounds(),
+                                      update.bound_upper_bounds());
+  }
+
+  if (clauses_ == nullptr) return;
+  const auto& binary = update.binary_clause_literals();
+  for (int i = 0; i + 1 < binary.size(); i += 2) {
+    const int a = binary[i];
+    const int b = binary[i + 1];
+    if (!is_valid_literal(a) || !is_valid_literal(b)) continue;
+    imported_binary_clauses_.insert({std::min(a, b), std::max(a, b)});
+    clauses_->AddBinaryClause(clauses_id_, a, b);
+  }
+  UniqueClauseStream* stream = clauses_->GetClauseStream(clauses_id_);
+  const absl::Span<const int> literals = update.clause_literals();
+  int start = 0;
+  for (const int size : update.clause_sizes()) {
+    if (size < 0 || start + size > literals.size()) break;
+    const absl::Span<const int> clause = literals.subspan(start, size);
+    start += size;
+    if (!absl::c_all_of(clause, is_valid_literal)) continue;
+    stream->Add(clause);
+  }
+}
+
+}  // namespace sat
+}  // namespace operations_research
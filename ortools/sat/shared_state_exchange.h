@@ -0,0 +1,146 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_SAT_SHARED_STATE_EXCHANGE_H_
+#define OR_TOOLS_SAT_SHARED_STATE_EXCHANGE_H_
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/shared_state.pb.h"
+#include "ortools/sat/synchronization.h"
+
+namespace operations_research {
+namespace sat {
+
+// Interface used to send SharedStateUpdate to, and receive them from, the other
+// processes of a distributed solve. An implementation can be backed by the
+// CpSolver.ExchangeSharedState() rpc, a socket, or anything else.
+//
+// To run a distributed solve, register one instance in the Model passed to
+// SolveCpModel() with model->Register<SharedStateTransport>(transport). It is
+// only used by the multi-thread solver and it must be thread-safe.
+class SharedStateTransport {
+ public:
+  virtual ~SharedStateTransport() = default;
+
+  // Sends the update to all the other processes.
+  virtual void Send(const SharedStateUpdate& update) = 0;
+
+  // Returns all the updates received since the last call.
+  virtual std::vector<SharedStateUpdate> Receive() = 0;
+};
+
+// In-process transport connecting any number of endpoints. An update sent by
+// one endpoint is received by all the others. This is mainly useful for tests,
+// or to run many "processes" in one binary.
+class LoopbackSharedStateHub {
+ public:
+  LoopbackSharedStateHub();
+  ~LoopbackSharedStateHub();
+
+  // This type is neither copyable nor movable.
+  LoopbackSharedStateHub(const LoopbackSharedStateHub&) = delete;
+  LoopbackSharedStateHub& operator=(const LoopbackSharedStateHub&) = delete;
+
+  // Returns a new endpoint. It is owned by the hub.
+  SharedStateTransport* NewEndpoint() ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  class Endpoint;
+
+  void Broadcast(int sender, const SharedStateUpdate& update)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+  std::vector<SharedStateUpdate> PopAll(int receiver)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<Endpoint>> endpoints_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::deque<SharedStateUpdate>> inboxes_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Connects the shared classes of one process to the other processes of a
+// distributed solve. Each Synchronize() sends what improved locally since the
+// last call and imports what the other processes sent.
+//
+// Imported data goes through the normal shared classes API, so it is filtered
+// exactly like the data of a local worker: a solution is only kept if it
+// improves, a bound only if it tightens, and duplicate clauses are ignored.
+// This also makes the small amount of "echo" (a process sending back what it
+// imported) harmless.
+//
+// The bounds and clauses managers can be nullptr, in which case the
+// corresponding information is neither sent nor imported.
+class SharedStateExchanger {
+ public:
+  SharedStateExchanger(absl::string_view name, const CpModelProto& model_proto,
+                       SharedStateTransport* transport,
+                       SharedResponseManager* response,
+                       SharedBoundsManager* bounds,
+                       SharedClausesManager* clauses);
+
+  // Not thread-safe, this is meant to be called by the synchronization
+  // subsolver, after the shared classes are synchronized.
+  void Synchronize();
+
+  int64_t num_sent() const { return num_sent_; }
+  int64_t num_imported() const { return num_imported_; }
+
+ private:
+  // Returns false if there is nothing to send.
+  bool FillUpdate(SharedStateUpdate* update);
+  void Import(const SharedStateUpdate& update);
+
+  const std::string name_;
+  const uint64_t model_fingerprint_;
+  const bool has_objective_;
+  const int num_variables_;
+  SharedStateTransport* transport_;
+  SharedResponseManager* response_;
+  SharedBoundsManager* bounds_;
+  SharedClausesManager* clauses_;
+  int bounds_id_ = -1;
+  int clauses_id_ = -1;
+
+  // What was last sent or imported, to only send improvements.
+  int64_t best_shared_rank_ = std::numeric_limits<int64_t>::max();
+  bool solution_shared_ = false;
+  int64_t shared_lower_bound_ = std::numeric_limits<int64_t>::min();
+  int64_t shared_upper_bound_ = std::numeric_limits<int64_t>::max();
+
+  // We do not send back the binary clauses we imported.
+  absl::flat_hash_set<std::pair<int, int>> imported_binary_clauses_;
+
+  std::vector<int> tmp_variables_;
+  std::vector<int64_t> tmp_lower_bounds_;
+  std::vector<int64_t> tmp_upper_bounds_;
+  std::vector<std::pair<int, int>> tmp_binary_clauses_;
+
+  int64_t num_sent_ = 0;
+  int64_t num_imported_ = 0;
+};
+
+}  // namespace sat
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_SAT_SHARED_STATE_EXCHANGE_H_
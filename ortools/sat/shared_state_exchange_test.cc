@@ -0,0 +1,115 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/shared_state_exchange.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/parse_test_proto.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/model.h"
+#include "ortools/sat/shared_state.pb.h"
+#include "ortools/sat/synchronization.h"
+
+namespace operations_research {
+namespace sat {
+namespace {
+
+using ::google::protobuf::contrib::parse_proto::ParseTestProto;
+using ::testing::ElementsAre;
+
+// The shared classes of one "process" of a distributed solve.
+struct Process {
+  Process(const CpModelProto& model_proto, SharedStateTransport* transport)
+      : response(&model),
+        bounds(model_proto),
+        exchanger("process", model_proto, transport, &response, &bounds,
+                  /*clauses=*/nullptr) {
+    response.InitializeObjective(model_proto);
+  }
+
+  void Synchronize() {
+    response.Synchronize();
+    response.MutableSolutionsRepository()->Synchronize();
+    bounds.Synchronize();
+    exchanger.Synchronize();
+  }
+
+  Model model;
+  SharedResponseManager response;
+  SharedBoundsManager bounds;
+  SharedStateExchanger exchanger;
+};
+
+const char kModel[] = R"pb(
+  variables { domain: [ 0, 10 ] }
+  variables { domain: [ 0, 10 ] }
+  objective {
+    vars: [ 0, 1 ]
+    coeffs: [ 1, 1 ]
+  }
+)pb";
+
+TEST(SharedStateExchangerTest, SolutionsAndBoundsAreShared) {
+  const CpModelProto model_proto = ParseTestProto(kModel);
+  LoopbackSharedStateHub hub;
+  Process a(model_proto, hub.NewEndpoint());
+  Process b(model_proto, hub.NewEndpoint());
+
+  const std::vector<int64_t> solution = {2, 3};
+  a.response.NewSolution(solution, "test");
+  a.bounds.ReportPotentialNewBounds("test", {1}, {0}, {5});
+  a.Synchronize();
+  b.Synchronize();
+  EXPECT_EQ(a.exchanger.num_sent(), 1);
+  EXPECT_EQ(b.exchanger.num_imported(), 1);
+
+  // The imported data is visible after the next synchronization.
+  b.Synchronize();
+  EXPECT_EQ(b.response.SolutionsRepository().NumSolutions(), 1);
+  EXPECT_EQ(b.response.GetInnerObjectiveUpperBound(), 4);
+
+  std::vector<int> vars;
+  std::vector<int64_t> lbs;
+  std::vector<int64_t> ubs;
+  const int id = b.bounds.RegisterNewId();
+  b.bounds.GetChangedBounds(id, &vars, &lbs, &ubs);
+  EXPECT_THAT(vars, ElementsAre(1));
+  EXPECT_THAT(ubs, ElementsAre(5));
+
+  // Nothing new on a, so no more update are sent.
+  const int64_t num_sent = a.exchanger.num_sent();
+  a.Synchronize();
+  EXPECT_EQ(a.exchanger.num_sent(), num_sent);
+}
+
+TEST(SharedStateExchangerTest, UpdatesForAnotherModelAreIgnored) {
+  const CpModelProto model_proto = ParseTestProto(kModel);
+  CpModelProto other_model_proto = model_proto;
+  other_model_proto.mutable_variables(0)->set_domain(1, 9);
+
+  LoopbackSharedStateHub hub;
+  Process a(model_proto, hub.NewEndpoint());
+  Process b(other_model_proto, hub.NewEndpoint());
+  a.bounds.ReportPotentialNewBounds("test", {1}, {0}, {5});
+  a.Synchronize();
+  b.Synchronize();
+  EXPECT_EQ(b.exchanger.num_imported(), 0);
+}
+
+}  // namespace
+}  // namespace sat
+}  // namespace operations_research
@@ -0,0 +1,221 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/solve_telemetry.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "ortools/base/timer.h"
+#include "ortools/sat/integer.h"
+#include "ortools/sat/integer_search.h"
+#include "ortools/sat/linear_programming_constraint.h"
+#include "ortools/sat/model.h"
+#include "ortools/sat/sat_solver.h"
+#include "ortools/sat/solve_telemetry.pb.h"
+#include "ortools/sat/subsolver.h"
+#include "ortools/util/time_limit.h"
+
+namespace operations_research {
+namespace sat {
+
+void SharedTelemetry::AddCallback(
+    std::function<void(const SolveTelemetry&)> callback) {
+  absl::MutexLock mutex_lock(&mutex_);
+  callbacks_.push_back(std::move(callback));
+}
+
+bool SharedTelemetry::HasCallbacks() const {
+  absl::MutexLock mutex_lock(&mutex_);
+  return !callbacks_.empty();
+}
+
+void SharedTelemetry::Start(double period_in_seconds,
+                            const WallTimer* wall_timer,
+                            const SharedTimeLimit* time_limit) {
+  absl::MutexLock mutex_lock(&mutex_);
+  period_in_seconds_ = period_in_seconds;
+  wall_timer_ = wall_timer;
+  time_limit_ = time_limit;
+  next_report_time_ = WallTime() + period_in_seconds_;
+}
+
+double SharedTelemetry::WallTime() const {
+  return wall_timer_ == nullptr ? 0.0 : wall_timer_->Get();
+}
+
+WorkerTelemetry* SharedTelemetry::GetOrCreateWorker(absl::string_view name) {
+  const auto [it, inserted] =
+      name_to_index_.insert({std::string(name), workers_.size()});
+  if (inserted) {
+    workers_.emplace_back().set_name(std::string(name));
+    last_reports_.emplace_back();
+  }
+  return &workers_[it->second];
+}
+
+void SharedTelemetry::UpdateWorker(const WorkerTelemetry& worker) {
+  absl::MutexLock mutex_lock(&mutex_);
+  WorkerTelemetry* stored = GetOrCreateWorker(worker.name());
+  const int64_t num_tasks = stored->num_tasks();
+  const double wall_time = stored->wall_time_in_seconds();
+  const double deterministic_time = stored->deterministic_time();
+  *stored = worker;
+  stored->set_num_tasks(num_tasks);
+  stored->set_wall_time_in_seconds(wall_time);
+  stored->set_deterministic_time(deterministic_time);
+  MaybeReport();
+}
+
+void SharedTelemetry::UpdateSubsolvers(
+    absl::Span<const std::unique_ptr<SubSolver>> subsolvers) {
+  absl::MutexLock mutex_lock(&mutex_);
+  for (const std::unique_ptr<SubSolver>& subsolver : subsolvers) {
+    if (subsolver == nullptr) continue;
+    if (subsolver->type() == SubSolver::HELPER) continue;
+    WorkerTelemetry* worker = GetOrCreateWorker(subsolver->name());
+    worker->set_num_tasks(subsolver->num_finished_tasks());
+    worker->set_wall_time_in_seconds(subsolver->wall_time());
+    worker->set_deterministic_time(subsolver->deterministic_time());
+  }
+  MaybeReport();
+}
+
+void SharedTelemetry::ReportFinal() {
+  absl::MutexLock mutex_lock(&mutex_);
+  if (callbacks_.empty()) return;
+  Report(/*is_final=*/true);
+}
+
+int64_t SharedTelemetry::num_reports() const {
+  absl::MutexLock mutex_lock(&mutex_);
+  return num_reports_;
+}
+
+void SharedTelemetry::MaybeReport() {
+  if (callbacks_.empty()) return;
+  const double now = WallTime();
+  if (now < next_report_time_) return;
+  next_report_time_ = now + period_in_seconds_;
+  Report(/*is_final=*/false);
+}
+
+void SharedTelemetry::Report(bool is_final) {
+  const double now = WallTime();
+  SolveTelemetry telemetry;
+  telemetry.set_wall_time_in_seconds(now);
+  if (time_limit_ != nullptr) {
+    telemetry.set_deterministic_time(
+        time_limit_->GetElapsedDeterministicTime());
+  }
+  telemetry.set_is_final(is_final);
+  for (int i = 0; i < workers_.size(); ++i) {
+    WorkerTelemetry* worker = telemetry.add_workers();
+    *worker = workers_[i];
+
+    const int64_t num_propagations = worker->num_binary_propagations() +
+                                     worker->num_integer_propagations();
+    LastReport& last = last_reports_[i];
+    const double elapsed = now - last.time;
+    if (elapsed > 0.0) {
+      worker->set_conflicts_per_second(
+          static_cast<double>(worker->num_conflicts() - last.num_conflicts) /
+          elapsed);
+      worker->set_propagations_per_second(
+          static_cast<double>(num_propagations - last.num_propagations) /
+          elapsed);
+    }
+    last.time = now;
+    last.num_conflicts = worker->num_conflicts();
+    last.num_propagations = num_propagations;
+  }
+
+  ++num_reports_;
+  for (const auto& callback : callbacks_) {
+    callback(telemetry);
+  }
+}
+
+void FillWorkerSearchTelemetry(Model* model, WorkerTelemetry* worker) {
+  auto* sat_solver = model->GetOrCreate<SatSolver>();
+  worker->set_num_conflicts(sat_solver->num_failures());
+  worker->set_num_branches(sat_solver->num_branches());
+  worker->set_num_binary_propagations(sat_solver->num_propagations());
+  worker->set_num_integer_propagations(
+      model->GetOrCreate<IntegerTrail>()->num_enqueues());
+
+  // Aggregate the propagators by tag.
+  auto* watcher = model->GetOrCreate<GenericLiteralWatcher>();
+  absl::flat_hash_map<absl::string_view, PropagatorTelemetry*> propagators;
+  for (int id = 0; id < watcher->NumPropagators(); ++id) {
+    const absl::string_view tag = watcher->PropagatorTag(id);
+    PropagatorTelemetry*& stats = propagators[tag];
+    if (stats == nullptr) {
+      stats = worker->add_propagators();
+      stats->set_name(std::string(tag));
+    }
+    stats->set_num_propagators(stats->num_propagators() + 1);
+    stats->set_num_calls(stats->num_calls() + watcher->PropagatorNumCalls(id));
+    stats->set_time_in_seconds(stats->time_in_seconds() +
+                               watcher->PropagatorEstimatedTime(id));
+  }
+
+  // Same for the cut generators of all the LP components.
+  int64_t num_lp_iterations = 0;
+  absl::flat_hash_map<absl::string_view, CutGeneratorTelemetry*> generators;
+  for (const LinearProgrammingConstraint* lp :
+       *model->GetOrCreate<LinearProgrammingConstraintCollection>()) {
+    num_lp_iterations += lp->total_num_simplex_iterations();
+    for (int i = 0; i < lp->num_cut_generators(); ++i) {
+      const absl::string_view name = lp->cut_generator_name(i);
+      CutGeneratorTelemetry*& stats = generators[name];
+      if (stats == nullptr) {
+        stats = worker->add_cut_generators();
+        stats->set_name(std::string(name));
+      }
+      stats->set_num_generators(stats->num_generators() + 1);
+      stats->set_num_calls(stats->num_calls() + lp->cut_generator_num_calls(i));
+      stats->set_time_in_seconds(stats->time_in_seconds() +
+                                 lp->cut_generator_time(i));
+    }
+  }
+  worker->set_num_lp_iterations(num_lp_iterations);
+}
+
+void RegisterWorkerTelemetryExport(absl::string_view name,
+                                   SharedTelemetry* telemetry, Model* model) {
+  model->GetOrCreate<GenericLiteralWatcher>()->EnableStatistics();
+  model->GetOrCreate<LevelZeroCallbackHelper>()->callbacks.push_back(
+      [name = std::string(name), telemetry, model,
+       next_export_time = 0.0]() mutable {
+        const double now = telemetry->WallTime();
+        if (now < next_export_time) return true;
+        next_export_time = now + telemetry->period_in_seconds();
+
+        WorkerTelemetry worker;
+        worker.set_name(name);
+        FillWorkerSearchTelemetry(model, &worker);
+        telemetry->UpdateWorker(worker);
+        return true;
+      });
+}
+
+}  // namespace sat
+}  // namespace operations_research
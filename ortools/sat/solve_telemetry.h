@@ -0,0 +1,121 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_SAT_SOLVE_TELEMETRY_H_
+#define OR_TOOLS_SAT_SOLVE_TELEMETRY_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "ortools/base/timer.h"
+#include "ortools/sat/model.h"
+#include "ortools/sat/solve_telemetry.pb.h"
+#include "ortools/sat/subsolver.h"
+#include "ortools/util/time_limit.h"
+
+namespace operations_research {
+namespace sat {
+
+// Collects the statistics of all the workers of a solve and periodically
+// reports them, as a SolveTelemetry, to the registered callbacks.
+//
+// The workers own their statistics and are not thread-safe, so each worker
+// pushes a snapshot of its own statistics with UpdateWorker(). The callbacks
+// are called from the thread whose update made the period elapse, while
+// holding a mutex, so they should be fast.
+class SharedTelemetry {
+ public:
+  SharedTelemetry() = default;
+
+  // This type is neither copyable nor movable.
+  SharedTelemetry(const SharedTelemetry&) = delete;
+  SharedTelemetry& operator=(const SharedTelemetry&) = delete;
+
+  void AddCallback(std::function<void(const SolveTelemetry&)> callback)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+  bool HasCallbacks() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Must be called once before the search starts. The given timer and time
+  // limit must outlive this class.
+  void Start(double period_in_seconds, const WallTimer* wall_timer,
+             const SharedTimeLimit* time_limit) ABSL_LOCKS_EXCLUDED(mutex_);
+  double period_in_seconds() const { return period_in_seconds_; }
+  double WallTime() const;
+
+  // Replaces the statistics of the worker with the same name, except its task
+  // timing which is filled by UpdateSubsolvers(). Thread-safe.
+  void UpdateWorker(const WorkerTelemetry& worker) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Updates the task timing of all the non-nullptr subsolvers. This must be
+  // called by the thread that runs the subsolvers loop.
+  void UpdateSubsolvers(absl::Span<const std::unique_ptr<SubSolver>> subsolvers)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Sends the last report, with is_final set to true.
+  void ReportFinal() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  int64_t num_reports() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  WorkerTelemetry* GetOrCreateWorker(absl::string_view name)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void MaybeReport() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void Report(bool is_final) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  double period_in_seconds_ = 1.0;
+  const WallTimer* wall_timer_ = nullptr;
+  const SharedTimeLimit* time_limit_ = nullptr;
+
+  mutable absl::Mutex mutex_;
+  std::vector<std::function<void(const SolveTelemetry&)>> callbacks_
+      ABSL_GUARDED_BY(mutex_);
+  double next_report_time_ ABSL_GUARDED_BY(mutex_) = 0.0;
+  int64_t num_reports_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  // In the order in which they were first seen.
+  std::vector<WorkerTelemetry> workers_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, int> name_to_index_ ABSL_GUARDED_BY(mutex_);
+
+  // The worker counters at the time of the last report, to compute the rates.
+  struct LastReport {
+    double time = 0.0;
+    int64_t num_conflicts = 0;
+    int64_t num_propagations = 0;
+  };
+  std::vector<LastReport> last_reports_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Fills the search statistics of a full problem worker from its model: the
+// SatSolver and LP counters, and the statistics of its propagators and cut
+// generators. This must be called by the thread that owns the model.
+void FillWorkerSearchTelemetry(Model* model, WorkerTelemetry* worker);
+
+// Enables the propagator statistics of the given worker model and registers a
+// level zero callback that periodically exports its statistics with
+// FillWorkerSearchTelemetry(). This should be called after the model is
+// loaded.
+void RegisterWorkerTelemetryExport(absl::string_view name,
+                                   SharedTelemetry* telemetry, Model* model);
+
+}  // namespace sat
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_SAT_SOLVE_TELEMETRY_H_
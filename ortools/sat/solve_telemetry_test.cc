@@ -0,0 +1,146 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/solve_telemetry.h"
+
+#include <vector>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/parse_test_proto.h"
+#include "ortools/base/timer.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_solver.h"
+#include "ortools/sat/integer.h"
+#include "ortools/sat/model.h"
+#include "ortools/sat/sat_base.h"
+#include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/sat/solve_telemetry.pb.h"
+
+namespace operations_research {
+namespace sat {
+namespace {
+
+using ::google::protobuf::contrib::parse_proto::ParseTestProto;
+
+TEST(SharedTelemetryTest, RatesAreComputedBetweenReports) {
+  WallTimer timer;
+  timer.Start();
+  SharedTelemetry telemetry;
+  std::vector<SolveTelemetry> reports;
+  telemetry.AddCallback(
+      [&reports](const SolveTelemetry& t) { reports.push_back(t); });
+  telemetry.Start(/*period_in_seconds=*/0.0, &timer, /*time_limit=*/nullptr);
+
+  WorkerTelemetry worker;
+  worker.set_name("worker");
+  worker.set_num_conflicts(10);
+  telemetry.UpdateWorker(worker);
+  absl::SleepFor(absl::Milliseconds(1));
+  worker.set_num_conflicts(30);
+  telemetry.UpdateWorker(worker);
+  telemetry.ReportFinal();
+
+  ASSERT_EQ(reports.size(), 3);
+  EXPECT_EQ(telemetry.num_reports(), 3);
+  ASSERT_EQ(reports[1].workers_size(), 1);
+  EXPECT_EQ(reports[1].workers(0).num_conflicts(), 30);
+  EXPECT_GT(reports[1].workers(0).conflicts_per_second(), 0.0);
+  EXPECT_TRUE(reports[2].is_final());
+  EXPECT_EQ(reports[2].workers(0).conflicts_per_second(), 0.0);
+}
+
+TEST(SolveTelemetryTest, FinalReportContainsTheWorkers) {
+  const CpModelProto model_proto = ParseTestProto(R"pb(
+    variables { domain: [ 0, 10 ] }
+    variables { domain: [ 0, 10 ] }
+    variables { domain: [ 0, 10 ] }
+    constraints {
+      all_diff {
+        exprs { vars: 0 coeffs: 1 }
+        exprs { vars: 1 coeffs: 1 }
+        exprs { vars: 2 coeffs: 1 }
+      }
+    }
+    objective {
+      vars: [ 0, 1, 2 ]
+      coeffs: [ 1, 2, 3 ]
+    }
+  )pb");
+  Model model;
+  SatParameters params;
+  params.set_num_workers(1);
+  params.set_cp_model_presolve(false);
+  params.set_telemetry_period_in_seconds(0.0);
+  model.Add(NewSatParameters(params));
+
+  std::vector<SolveTelemetry> reports;
+  model.Add(NewSolveTelemetryCallback(
+      [&reports](const SolveTelemetry& t) { reports.push_back(t); }));
+  const CpSolverResponse response = SolveCpModel(model_proto, &model);
+  EXPECT_EQ(response.status(), CpSolverStatus::OPTIMAL);
+
+  ASSERT_FALSE(reports.empty());
+  const SolveTelemetry& last = reports.back();
+  EXPECT_TRUE(last.is_final());
+  ASSERT_EQ(last.workers_size(), 1);
+  EXPECT_EQ(last.workers(0).name(), "main");
+  EXPECT_EQ(last.workers(0).num_tasks(), 1);
+
+  bool all_diff_found = false;
+  for (const PropagatorTelemetry& propagator : last.workers(0).propagators()) {
+    if (propagator.name() == "kAllDiff") {
+      all_diff_found = true;
+      EXPECT_GT(propagator.num_calls(), 0);
+    }
+  }
+  EXPECT_TRUE(all_diff_found);
+}
+
+class SleepingPropagator : public PropagatorInterface {
+ public:
+  bool Propagate() final {
+    absl::SleepFor(absl::Microseconds(1));
+    return true;
+  }
+};
+
+TEST(GenericLiteralWatcherTest, PeriodicWakeUpsAreAllTimed) {
+  Model model;
+  GenericLiteralWatcher* watcher = model.GetOrCreate<GenericLiteralWatcher>();
+  watcher->EnableStatistics();
+  SleepingPropagator even;
+  SleepingPropagator odd;
+  const int even_id = watcher->Register(&even);
+  const int odd_id = watcher->Register(&odd);
+
+  // The two propagators are woken up alternately, so a timing period that is
+  // a multiple of two would only ever time one of them.
+  Trail* trail = model.GetOrCreate<Trail>();
+  for (int i = 0; i < 1000; ++i) {
+    watcher->CallOnNextPropagate(i % 2 == 0 ? even_id : odd_id);
+    ASSERT_TRUE(watcher->Propagate(trail));
+  }
+
+  // Both propagators are also called once at the first Propagate().
+  EXPECT_EQ(watcher->PropagatorNumCalls(even_id), 500);
+  EXPECT_EQ(watcher->PropagatorNumCalls(odd_id), 501);
+  EXPECT_GT(watcher->PropagatorEstimatedTime(even_id), 0.0);
+  EXPECT_GT(watcher->PropagatorEstimatedTime(odd_id), 0.0);
+}
+
+}  // namespace
+}  // namespace sat
+}  // namespace operations_research
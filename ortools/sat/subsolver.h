@@ -18,6 +18,7 @@
 #define OR_TOOLS_SAT_SUBSOLVER_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <functional>
@@ -89,7 +90,18 @@ class SubSolver {
 
   // Returns the total deterministic time spend by the completed tasks before
   // the last Synchronize() call.
-  double deterministic_time() const { return deterministic_time_; }
+  double deterministic_time() const {
+    return deterministic_time_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the total wall time and number of the completed tasks. These can
+  // be read from any thread, while tasks are still running.
+  double wall_time() const {
+    return wall_time_.load(std::memory_order_relaxed);
+  }
+  int64_t num_finished_tasks() const {
+    return num_finished_tasks_.load(std::memory_order_relaxed);
+  }
 
   // Returns the name of this SubSolver. Used in logs.
   std::string name() const { return name_; }
@@ -100,8 +112,9 @@ class SubSolver {
   // Note that this is protected by the global execution mutex and so it is
   // called sequentially. Subclasses do not need to call this.
   void AddTaskDuration(double duration_in_seconds) {
-    ++num_finished_tasks_;
-    wall_time_ += duration_in_seconds;
+    num_finished_tasks_.fetch_add(1, std::memory_order_relaxed);
+    wall_time_.store(wall_time() + duration_in_seconds,
+                     std::memory_order_relaxed);
     timing_.AddTimeInSec(duration_in_seconds);
   }
 
@@ -113,7 +126,8 @@ class SubSolver {
   // or from the task itself it we execute a single task at the same time.
   void AddTaskDeterministicDuration(double deterministic_duration) {
     if (deterministic_duration <= 0) return;
-    deterministic_time_ += deterministic_duration;
+    deterministic_time_.store(deterministic_time() + deterministic_duration,
+                              std::memory_order_relaxed);
     dtiming_.AddTimeInSec(deterministic_duration);
   }
 
@@ -139,7 +153,7 @@ class SubSolver {
   // time should only be used with the DeterministicLoop() because otherwise it
   // can be updated at the same time as this is called.
   double GetSelectionScore(bool deterministic) const {
-    const double time = deterministic ? deterministic_time_ : wall_time_;
+    const double time = deterministic ? deterministic_time() : wall_time();
     const double divisor = num_scheduled_tasks_ > 0
                                ? static_cast<double>(num_scheduled_tasks_)
                                : 1.0;
@@ -147,9 +161,10 @@ class SubSolver {
     // If we have little data, we strongly limit the number of task in flight.
     // This is needed if some LNS are stuck for a long time to not just only
     // schedule this type at the beginning.
-    const int64_t in_flight = num_scheduled_tasks_ - num_finished_tasks_;
+    const int64_t num_finished_tasks = this->num_finished_tasks();
+    const int64_t in_flight = num_scheduled_tasks_ - num_finished_tasks;
     const double confidence_factor =
-        num_finished_tasks_ > 10 ? 1.0 : std::exp(in_flight);
+        num_finished_tasks > 10 ? 1.0 : std::exp(in_flight);
 
     // We assume a "minimum time per task" which will be our base etimation for
     // the average running time of this task.
@@ -162,11 +177,15 @@ class SubSolver {
   const SubsolverType type_;
 
   int64_t num_scheduled_tasks_ = 0;
-  int64_t num_finished_tasks_ = 0;
+
+  // These are atomic so that the statistics can be read while tasks complete.
+  // Each one only has one writer at a time, so a load and a store are enough
+  // to update them.
+  std::atomic<int64_t> num_finished_tasks_ = 0;
 
   // Sum of wall_time / deterministic_time.
-  double wall_time_ = 0.0;
-  double deterministic_time_ = 0.0;
+  std::atomic<double> wall_time_ = 0.0;
+  std::atomic<double> deterministic_time_ = 0.0;
 
   TimeDistribution timing_ = TimeDistribution("task time");
   TimeDistribution dtiming_ = TimeDistribution("task dtime");
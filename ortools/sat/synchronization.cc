@@ -834,17 +834,18 @@ SharedBoundsManager::SharedBoundsManager(const CpModelProto& model_proto)
       model_proto_(model_proto),
       lower_bounds_(num_variables_, std::numeric_limits<int64_t>::min()),
       upper_bounds_(num_variables_, std::numeric_limits<int64_t>::max()),
-      synchronized_lower_bounds_(num_variables_,
-                                 std::numeric_limits<int64_t>::min()),
-      synchronized_upper_bounds_(num_variables_,
-                                 std::numeric_limits<int64_t>::max()) {
+      synchronized_lower_bounds_(num_variables_),
+      synchronized_upper_bounds_(num_variables_),
+      variable_last_stamp_(num_variables_, -1) {
   changed_variables_since_last_synchronize_.ClearAndResize(num_variables_);
   for (int i = 0; i < num_variables_; ++i) {
     lower_bounds_[i] = model_proto.variables(i).domain(0);
     const int domain_size = model_proto.variables(i).domain_size();
     upper_bounds_[i] = model_proto.variables(i).domain(domain_size - 1);
-    synchronized_lower_bounds_[i] = lower_bounds_[i];
-    synchronized_upper_bounds_[i] = upper_bounds_[i];
+    synchronized_lower_bounds_[i].store(lower_bounds_[i],
+                                        std::memory_order_relaxed);
+    synchronized_upper_bounds_[i].store(upper_bounds_[i],
+                                        std::memory_order_relaxed);
   }
 
   // Fill symmetry data.
@@ -1020,28 +1021,44 @@ void SharedBoundsManager::Synchronize() {
   for (const int var :
        changed_variables_since_last_synchronize_.PositionsSetAtLeastOnce()) {
     DCHECK(!has_symmetry_ || var_to_representative_[var] == var);
-    synchronized_lower_bounds_[var] = lower_bounds_[var];
-    synchronized_upper_bounds_[var] = upper_bounds_[var];
-    for (int j = 0; j < id_to_changed_variables_.size(); ++j) {
-      id_to_changed_variables_[j].Set(var);
-    }
+    synchronized_lower_bounds_[var].store(lower_bounds_[var],
+                                          std::memory_order_relaxed);
+    synchronized_upper_bounds_[var].store(upper_bounds_[var],
+                                          std::memory_order_relaxed);
+    variable_last_stamp_[var] =
+        num_removed_changes_ + synchronized_changes_.size();
+    synchronized_changes_.push_back(var);
   }
   changed_variables_since_last_synchronize_.ClearAll();
+
+  // Forget the part of the log that all ids have processed. We only do it when
+  // this is at least half of the log so that this is amortized O(1) per entry.
+  int64_t min_next_stamp = num_removed_changes_ + synchronized_changes_.size();
+  for (const int64_t stamp : id_to_next_stamp_) {
+    min_next_stamp = std::min(min_next_stamp, stamp);
+  }
+  const int64_t num_to_remove = min_next_stamp - num_removed_changes_;
+  if (num_to_remove > 0 && 2 * num_to_remove >= synchronized_changes_.size()) {
+    synchronized_changes_.erase(synchronized_changes_.begin(),
+                                synchronized_changes_.begin() + num_to_remove);
+    num_removed_changes_ = min_next_stamp;
+  }
 }
 
 int SharedBoundsManager::RegisterNewId() {
   absl::MutexLock mutex_lock(&mutex_);
-  const int id = id_to_changed_variables_.size();
-  id_to_changed_variables_.resize(id + 1);
-  id_to_changed_variables_[id].ClearAndResize(num_variables_);
+  const int id = id_to_next_stamp_.size();
+  id_to_next_stamp_.push_back(num_removed_changes_ +
+                              synchronized_changes_.size());
+  id_to_initial_changes_.emplace_back();
   for (int var = 0; var < num_variables_; ++var) {
     const int64_t lb = model_proto_.variables(var).domain(0);
     const int domain_size = model_proto_.variables(var).domain_size();
     const int64_t ub = model_proto_.variables(var).domain(domain_size - 1);
-    if (lb != synchronized_lower_bounds_[var] ||
-        ub != synchronized_upper_bounds_[var]) {
+    if (lb != synchronized_lower_bounds_[var].load(std::memory_order_relaxed) ||
+        ub != synchronized_upper_bounds_[var].load(std::memory_order_relaxed)) {
       DCHECK(!has_symmetry_ || var_to_representative_[var] == var);
-      id_to_changed_variables_[id].Set(var);
+      id_to_initial_changes_[id].push_back(var);
     }
   }
   return id;
@@ -1056,20 +1073,36 @@ void SharedBoundsManager::GetChangedBounds(
 
   {
     absl::MutexLock mutex_lock(&mutex_);
-    for (const int var :
-         id_to_changed_variables_[id].PositionsSetAtLeastOnce()) {
+    const int64_t next_stamp = id_to_next_stamp_[id];
+
+    // The initial changes that also appear in the log are reported below.
+    for (const int var : id_to_initial_changes_[id]) {
+      if (variable_last_stamp_[var] >= next_stamp) continue;
+      variables->push_back(var);
+    }
+    id_to_initial_changes_[id].clear();
+
+    // Only the last entry of each variable is reported, so each variable
+    // appears at most once.
+    const int64_t end_stamp =
+        num_removed_changes_ + synchronized_changes_.size();
+    for (int64_t stamp = next_stamp; stamp < end_stamp; ++stamp) {
+      const int var = synchronized_changes_[stamp - num_removed_changes_];
+      if (variable_last_stamp_[var] != stamp) continue;
       DCHECK(!has_symmetry_ || var_to_representative_[var] == var);
       variables->push_back(var);
     }
-    id_to_changed_variables_[id].ClearAll();
+    id_to_next_stamp_[id] = end_stamp;
 
     // We need to report the bounds in a deterministic order as it is difficult
     // to guarantee that nothing depend on the order in which the new bounds are
     // processed.
     absl::c_sort(*variables);
     for (const int var : *variables) {
-      new_lower_bounds->push_back(synchronized_lower_bounds_[var]);
-      new_upper_bounds->push_back(synchronized_upper_bounds_[var]);
+      new_lower_bounds->push_back(
+          synchronized_lower_bounds_[var].load(std::memory_order_relaxed));
+      new_upper_bounds->push_back(
+          synchronized_upper_bounds_[var].load(std::memory_order_relaxed));
     }
   }
 
@@ -1098,11 +1131,11 @@ void SharedBoundsManager::GetChangedBounds(
 }
 
 void SharedBoundsManager::UpdateDomains(std::vector<Domain>* domains) {
-  absl::MutexLock mutex_lock(&mutex_);
   CHECK_EQ(domains->size(), synchronized_lower_bounds_.size());
   for (int var = 0; var < domains->size(); ++var) {
     (*domains)[var] = (*domains)[var].IntersectionWith(Domain(
-        synchronized_lower_bounds_[var], synchronized_upper_bounds_[var]));
+        synchronized_lower_bounds_[var].load(std::memory_order_relaxed),
+        synchronized_upper_bounds_[var].load(std::memory_order_relaxed)));
   }
 }
 
@@ -550,13 +550,15 @@ class SharedBoundsManager {
   int RegisterNewId();
 
   // When called, returns the set of bounds improvements since
-  // the last time this method was called with the same id.
+  // the last time this method was called with the same id. This is in
+  // O(number of synchronized changes since the last call).
   void GetChangedBounds(int id, std::vector<int>* variables,
                         std::vector<int64_t>* new_lower_bounds,
                         std::vector<int64_t>* new_upper_bounds);
 
-  // This should not be called too often as it lock the class for
-  // O(num_variables) time.
+  // Intersects the given domains with the synchronized bounds. This does not
+  // lock the class, but it is O(num_variables), so it should not be called too
+  // often.
   void UpdateDomains(std::vector<Domain>* domains);
 
   // Publishes any new bounds so that GetChangedBounds() will reflect the latest
@@ -591,11 +593,27 @@ class SharedBoundsManager {
       ABSL_GUARDED_BY(mutex_);
   int64_t total_num_improvements_ ABSL_GUARDED_BY(mutex_) = 0;
 
-  // These are only updated on Synchronize().
-  std::vector<int64_t> synchronized_lower_bounds_ ABSL_GUARDED_BY(mutex_);
-  std::vector<int64_t> synchronized_upper_bounds_ ABSL_GUARDED_BY(mutex_);
-  std::deque<SparseBitset<int>> id_to_changed_variables_
-      ABSL_GUARDED_BY(mutex_);
+  // These are only updated on Synchronize(), under the mutex. Since bounds
+  // only get tighter, they can be read at any time without locking: each value
+  // read is a valid bound, even if the lower and upper bounds of a variable do
+  // not come from the same Synchronize().
+  std::vector<std::atomic<int64_t>> synchronized_lower_bounds_;
+  std::vector<std::atomic<int64_t>> synchronized_upper_bounds_;
+
+  // Log of the variables whose synchronized bounds changed, in order. Entries
+  // are identified by a "stamp" which is their position in the log counting
+  // the num_removed_changes_ entries that were already seen by all ids and
+  // removed. A variable can appear many times, only its last entry, whose stamp
+  // is in variable_last_stamp_, is used. Each id only remembers the stamp of
+  // the first entry it did not process yet, so Synchronize() does not depend
+  // on the number of ids.
+  std::vector<int> synchronized_changes_ ABSL_GUARDED_BY(mutex_);
+  int64_t num_removed_changes_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::vector<int64_t> variable_last_stamp_ ABSL_GUARDED_BY(mutex_);
+  std::vector<int64_t> id_to_next_stamp_ ABSL_GUARDED_BY(mutex_);
+
+  // Variables whose bounds were already tightened when the id was registered.
+  std::vector<std::vector<int>> id_to_initial_changes_ ABSL_GUARDED_BY(mutex_);
 
   // We track the number of bounds exported by each solver, and the "extra"
   // bounds pushed due to symmetries.
@@ -0,0 +1,126 @@
+// Copyright 2010-2025 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/synchronization.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/parse_test_proto.h"
+#include "ortools/sat/cp_model.pb.h"
+
+namespace operations_research {
+namespace sat {
+namespace {
+
+using ::google::protobuf::contrib::parse_proto::ParseTestProto;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+CpModelProto ThreeVariablesModel() {
+  return ParseTestProto(R"pb(
+    variables { domain: [ 0, 10 ] }
+    variables { domain: [ 0, 10 ] }
+    variables { domain: [ 0, 10 ] }
+  )pb");
+}
+
+struct ChangedBounds {
+  std::vector<int> variables;
+  std::vector<int64_t> lower_bounds;
+  std::vector<int64_t> upper_bounds;
+};
+
+ChangedBounds GetChangedBounds(SharedBoundsManager& manager, int id) {
+  ChangedBounds result;
+  manager.GetChangedBounds(id, &result.variables, &result.lower_bounds,
+                           &result.upper_bounds);
+  return result;
+}
+
+TEST(SharedBoundsManagerTest, SeveralIdsReadTheSameChanges) {
+  const CpModelProto model_proto = ThreeVariablesModel();
+  SharedBoundsManager manager(model_proto);
+  const int first_id = manager.RegisterNewId();
+  const int second_id = manager.RegisterNewId();
+
+  manager.ReportPotentialNewBounds("worker", {2, 0}, {0, 2}, {7, 10});
+  manager.Synchronize();
+
+  for (const int id : {first_id, second_id}) {
+    const ChangedBounds changes = GetChangedBounds(manager, id);
+    EXPECT_THAT(changes.variables, ElementsAre(0, 2));
+    EXPECT_THAT(changes.lower_bounds, ElementsAre(2, 0));
+    EXPECT_THAT(changes.upper_bounds, ElementsAre(10, 7));
+  }
+  EXPECT_THAT(GetChangedBounds(manager, first_id).variables, IsEmpty());
+
+  // The entry of the new change must stay in the log until the second id
+  // reads it, even if the first one already did.
+  manager.ReportPotentialNewBounds("worker", {1}, {3}, {10});
+  manager.Synchronize();
+  EXPECT_THAT(GetChangedBounds(manager, first_id).variables, ElementsAre(1));
+  manager.Synchronize();
+  const ChangedBounds changes = GetChangedBounds(manager, second_id);
+  EXPECT_THAT(changes.variables, ElementsAre(1));
+  EXPECT_THAT(changes.lower_bounds, ElementsAre(3));
+  EXPECT_THAT(changes.upper_bounds, ElementsAre(10));
+}
+
+TEST(SharedBoundsManagerTest, IdRegisteredAfterTheLogWasTrimmed) {
+  const CpModelProto model_proto = ThreeVariablesModel();
+  SharedBoundsManager manager(model_proto);
+  const int first_id = manager.RegisterNewId();
+
+  manager.ReportPotentialNewBounds("worker", {0}, {5}, {10});
+  manager.Synchronize();
+  EXPECT_THAT(GetChangedBounds(manager, first_id).variables, ElementsAre(0));
+
+  // The entry of variable 0 was read by all ids, so it is removed from the log
+  // here.
+  manager.ReportPotentialNewBounds("worker", {1}, {0}, {4});
+  manager.Synchronize();
+
+  const int second_id = manager.RegisterNewId();
+  const ChangedBounds changes = GetChangedBounds(manager, second_id);
+  EXPECT_THAT(changes.variables, ElementsAre(0, 1));
+  EXPECT_THAT(changes.lower_bounds, ElementsAre(5, 0));
+  EXPECT_THAT(changes.upper_bounds, ElementsAre(10, 4));
+  EXPECT_THAT(GetChangedBounds(manager, second_id).variables, IsEmpty());
+  EXPECT_THAT(GetChangedBounds(manager, first_id).variables, ElementsAre(1));
+}
+
+TEST(SharedBoundsManagerTest, RepeatedUpdatesAreReportedOnceWithLatestBounds) {
+  const CpModelProto model_proto = ThreeVariablesModel();
+  SharedBoundsManager manager(model_proto);
+  const int id = manager.RegisterNewId();
+
+  manager.ReportPotentialNewBounds("worker", {0}, {1}, {10});
+  manager.Synchronize();
+  manager.ReportPotentialNewBounds("worker", {0, 2}, {3, 0}, {10, 9});
+  manager.Synchronize();
+  manager.ReportPotentialNewBounds("worker", {0}, {3}, {6});
+  manager.Synchronize();
+
+  const ChangedBounds changes = GetChangedBounds(manager, id);
+  EXPECT_THAT(changes.variables, ElementsAre(0, 2));
+  EXPECT_THAT(changes.lower_bounds, ElementsAre(3, 0));
+  EXPECT_THAT(changes.upper_bounds, ElementsAre(6, 9));
+  EXPECT_THAT(GetChangedBounds(manager, id).variables, IsEmpty());
+}
+
+}  // namespace
+}  // namespace sat
+}  // namespace operations_research
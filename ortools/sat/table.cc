@@ -13,16 +13,20 @@
 
 #include "ortools/sat/table.h"
 
+#include <cstdint>
 #include <functional>
+#include <numeric>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/types/span.h"
+#include "ortools/sat/integer.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_solver.h"
+#include "ortools/sat/util.h"
 
 namespace operations_research {
 namespace sat {
@@ -78,5 +82,194 @@ std::function<void(Model*)> LiteralTableConstraint(
   };
 }
 
+CompactTablePropagator::CompactTablePropagator(
+    absl::Span<const std::vector<Literal>> literal_tuples, Model* model)
+    : assignment_(model->GetOrCreate<Trail>()->Assignment()),
+      trail_(model->GetOrCreate<Trail>()) {
+  const int num_tuples = literal_tuples.size();
+  CHECK_GT(num_tuples, 0);
+  const int num_columns = literal_tuples[0].size();
+
+  // Create the entries and the (word, mask) of the tuples containing them.
+  // Since the tuples are scanned in order, the words of an entry are
+  // increasing and we only need to look at the last one to merge them.
+  std::vector<absl::flat_hash_map<LiteralIndex, int>> column_to_entries(
+      num_columns);
+  std::vector<int> keys;
+  std::vector<std::pair<int, uint64_t>> values;
+  std::vector<int> last_value_of_entry;
+  for (int t = 0; t < num_tuples; ++t) {
+    CHECK_EQ(literal_tuples[t].size(), num_columns);
+    const int word = t / 64;
+    const uint64_t mask = uint64_t{1} << (t % 64);
+    for (int c = 0; c < num_columns; ++c) {
+      const Literal literal = literal_tuples[t][c];
+      const int new_entry = entry_literals_.size();
+      const auto [it, inserted] =
+          column_to_entries[c].insert({literal.Index(), new_entry});
+      const int entry = it->second;
+      if (inserted) {
+        entry_literals_.push_back(literal);
+        entry_columns_.push_back(c);
+        last_value_of_entry.push_back(-1);
+      }
+      const int last = last_value_of_entry[entry];
+      if (last != -1 && values[last].first == word) {
+        values[last].second |= mask;
+      } else {
+        last_value_of_entry[entry] = values.size();
+        keys.push_back(entry);
+        values.push_back({word, mask});
+      }
+    }
+  }
+  supports_.ResetFromFlatMapping(keys, values);
+
+  const int num_entries = entry_literals_.size();
+  residues_.assign(num_entries, 0);
+  entries_.resize(num_entries);
+  std::iota(entries_.begin(), entries_.end(), 0);
+  entry_positions_ = entries_;
+
+  const int num_words = (num_tuples + 63) / 64;
+  words_.assign(num_words, ~uint64_t{0});
+  if (num_tuples % 64 != 0) {
+    words_.back() = (uint64_t{1} << (num_tuples % 64)) - 1;
+  }
+  num_non_zero_words_ = num_words;
+  non_zero_words_.resize(num_words);
+  std::iota(non_zero_words_.begin(), non_zero_words_.end(), 0);
+  word_positions_ = non_zero_words_;
+}
+
+void CompactTablePropagator::RegisterWith(GenericLiteralWatcher* watcher) {
+  const int id = watcher->Register(this);
+  for (const Literal literal : entry_literals_) {
+    watcher->WatchLiteral(literal.Negated(), id);
+  }
+  watcher->RegisterReversibleClass(id, this);
+  watcher->RegisterReversibleInt(id, &num_non_zero_words_);
+  watcher->RegisterReversibleInt(id, &num_removed_entries_);
+
+  // A literal can appear in more than one column. When we fix it to false
+  // because of one column, we need to be called again to remove its tuples
+  // for the other columns.
+  watcher->NotifyThatPropagatorMayNotReachFixedPointInOnePass(id);
+}
+
+void CompactTablePropagator::SetLevel(int level) {
+  if (level == level_ends_.size()) return;
+  if (level > level_ends_.size()) {
+    while (level > level_ends_.size()) {
+      level_ends_.push_back(saved_words_.size());
+    }
+    return;
+  }
+
+  // Backtrack.
+  for (int i = saved_words_.size() - 1; i >= level_ends_[level]; --i) {
+    words_[saved_words_[i].first] = saved_words_[i].second;
+  }
+  saved_words_.resize(level_ends_[level]);
+  level_ends_.resize(level);
+}
+
+void CompactTablePropagator::SetWord(int word, uint64_t value) {
+  if (!level_ends_.empty()) saved_words_.push_back({word, words_[word]});
+  words_[word] = value;
+}
+
+void CompactTablePropagator::RemoveEntry(int entry) {
+  for (const auto [word, mask] : supports_[entry]) {
+    const uint64_t old_value = words_[word];
+    if ((old_value & mask) == 0) continue;
+    const uint64_t new_value = old_value & ~mask;
+    SetWord(word, new_value);
+    if (new_value != 0) continue;
+
+    // Remove the word from the non-zero words.
+    const int position = word_positions_[word];
+    const int last = --num_non_zero_words_;
+    const int last_word = non_zero_words_[last];
+    std::swap(non_zero_words_[position], non_zero_words_[last]);
+    word_positions_[last_word] = position;
+    word_positions_[word] = last;
+  }
+
+  // Move the entry to the removed prefix.
+  const int position = entry_positions_[entry];
+  const int first = num_removed_entries_++;
+  const int first_entry = entries_[first];
+  std::swap(entries_[position], entries_[first]);
+  entry_positions_[first_entry] = position;
+  entry_positions_[entry] = first;
+}
+
+bool CompactTablePropagator::EntryIsSupported(int entry) {
+  const absl::Span<const std::pair<int, uint64_t>> support = supports_[entry];
+  const auto [residue_word, residue_mask] = support[residues_[entry]];
+  if ((words_[residue_word] & residue_mask) != 0) return true;
+  for (int i = 0; i < support.size(); ++i) {
+    if ((words_[support[i].first] & support[i].second) != 0) {
+      residues_[entry] = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// All the tuples containing an unsupported entry were removed because of an
+// entry of another column, so the removed entries of the other columns are
+// enough to explain it.
+void CompactTablePropagator::FillReason(int column,
+                                        std::vector<Literal>* reason) const {
+  reason->clear();
+  for (int i = 0; i < num_removed_entries_; ++i) {
+    const int entry = entries_[i];
+    if (entry_columns_[entry] == column) continue;
+    DCHECK(assignment_.LiteralIsFalse(entry_literals_[entry]));
+    reason->push_back(entry_literals_[entry]);
+  }
+}
+
+bool CompactTablePropagator::Propagate() {
+  // Remove the tuples of the entries that became false. Note that RemoveEntry()
+  // swaps entries_[i] with an entry before it that was already processed.
+  for (int i = num_removed_entries_; i < entries_.size(); ++i) {
+    const int entry = entries_[i];
+    if (assignment_.LiteralIsFalse(entry_literals_[entry])) {
+      RemoveEntry(entry);
+    }
+  }
+  if (num_non_zero_words_ == 0) {
+    FillReason(/*column=*/-1, trail_->MutableConflict());
+    return false;
+  }
+
+  // Fix to false the entries not contained in any valid tuple.
+  for (int i = num_removed_entries_; i < entries_.size(); ++i) {
+    const int entry = entries_[i];
+    const Literal literal = entry_literals_[entry];
+    if (assignment_.LiteralIsFalse(literal)) continue;
+    if (EntryIsSupported(entry)) continue;
+    FillReason(entry_columns_[entry], trail_->GetEmptyVectorToStoreReason());
+    if (!trail_->EnqueueWithStoredReason(literal.Negated())) return false;
+  }
+  return true;
+}
+
+void AddCompactTableConstraint(
+    absl::Span<const std::vector<Literal>> literal_tuples, Model* model) {
+  if (literal_tuples.empty()) {
+    model->GetOrCreate<SatSolver>()->NotifyThatModelIsUnsat();
+    return;
+  }
+  if (literal_tuples[0].empty()) return;
+  CompactTablePropagator* constraint =
+      new CompactTablePropagator(literal_tuples, model);
+  constraint->RegisterWith(model->GetOrCreate<GenericLiteralWatcher>());
+  model->TakeOwnership(constraint);
+}
+
 }  // namespace sat
 }  // namespace operations_research
@@ -14,12 +14,17 @@
 #ifndef OR_TOOLS_SAT_TABLE_H_
 #define OR_TOOLS_SAT_TABLE_H_
 
+#include <cstdint>
 #include <functional>
+#include <utility>
 #include <vector>
 
 #include "absl/types/span.h"
+#include "ortools/sat/integer.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
+#include "ortools/sat/util.h"
+#include "ortools/util/rev.h"
 
 namespace operations_research {
 namespace sat {
@@ -32,6 +37,83 @@ std::function<void(Model*)> LiteralTableConstraint(
     absl::Span<const std::vector<Literal>> literal_tuples,
     absl::Span<const Literal> line_literals);
 
+// Enforces that at least one line of the literal_tuples matrix has all its
+// literals true. Like for LiteralTableConstraint(), this assumes that exactly
+// one literal per column is true, so it is usually used with the full encoding
+// of one variable per column.
+//
+// Unlike LiteralTableConstraint(), this does not create any new literals. It
+// uses the "Compact-Table" algorithm: the set of tuples still valid is a
+// reversible bitset, and each (column, literal) has the bitset of the tuples
+// it appears in. When a literal becomes false, its tuples are removed with a
+// few word operations, and a literal is fixed to false once it does not appear
+// in any valid tuple anymore. This scales to tables with millions of tuples.
+class CompactTablePropagator : public PropagatorInterface,
+                               public ReversibleInterface {
+ public:
+  CompactTablePropagator(absl::Span<const std::vector<Literal>> literal_tuples,
+                         Model* model);
+
+  // This type is neither copyable nor movable.
+  CompactTablePropagator(const CompactTablePropagator&) = delete;
+  CompactTablePropagator& operator=(const CompactTablePropagator&) = delete;
+
+  bool Propagate() final;
+  void SetLevel(int level) final;
+  void RegisterWith(GenericLiteralWatcher* watcher);
+
+ private:
+  // Removes all the tuples containing the given entry from the valid tuples.
+  void RemoveEntry(int entry);
+
+  // Returns true if at least one valid tuple contains the given entry. This
+  // updates the residue of the entry.
+  bool EntryIsSupported(int entry);
+
+  // Fills the reason for the entries of all the columns but the given one, or
+  // of all the columns if column is -1, to be not supported.
+  void FillReason(int column, std::vector<Literal>* reason) const;
+
+  void SetWord(int word, uint64_t value);
+
+  const VariablesAssignment& assignment_;
+  Trail* trail_;
+
+  // An entry is a literal of a column. Note that the same literal can appear
+  // in many columns, it will then correspond to many entries.
+  std::vector<Literal> entry_literals_;
+  std::vector<int> entry_columns_;
+
+  // For each entry, the non-zero words of the bitset of the tuples containing
+  // it, as (word index, mask) pairs.
+  CompactVectorVector<int, std::pair<int, uint64_t>> supports_;
+
+  // Index in supports_[entry] of the last word where we found a valid tuple
+  // containing the entry. This does not need to be restored on backtrack.
+  std::vector<int> residues_;
+
+  // The bitset of valid tuples, restored on backtrack with saved_words_.
+  std::vector<uint64_t> words_;
+  std::vector<std::pair<int, uint64_t>> saved_words_;
+  std::vector<int> level_ends_;
+
+  // Reversible set of the non-zero words of words_, in the prefix
+  // [0, num_non_zero_words_) of non_zero_words_.
+  int num_non_zero_words_;
+  std::vector<int> non_zero_words_;
+  std::vector<int> word_positions_;
+
+  // Reversible set of the entries already removed, in the prefix
+  // [0, num_removed_entries_) of entries_. All these have a false literal.
+  int num_removed_entries_ = 0;
+  std::vector<int> entries_;
+  std::vector<int> entry_positions_;
+};
+
+// Adds a CompactTablePropagator to the model. See its documentation.
+void AddCompactTableConstraint(
+    absl::Span<const std::vector<Literal>> literal_tuples, Model* model);
+
 }  // namespace sat
 }  // namespace operations_research
 
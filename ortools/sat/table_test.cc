@@ -682,6 +682,127 @@ TEST(LiteralTableConstraint, PropagationFromSelected) {
   EXPECT_TRUE(sat_solver->Assignment().LiteralIsFalse(literals[1][1]));
 }
 
+TEST(CompactTablePropagatorTest, PropagationFromLiterals) {
+  Model model;
+  std::vector<std::vector<Literal>> literals(3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      literals[i].push_back(Literal(model.Add(NewBooleanVariable()), true));
+    }
+    model.Add(ExactlyOneConstraint(literals[i]));
+  }
+
+  // Tuples (0, 0, 0), (1, 1, 1), (2, 2, 2), (0, 1, 2).
+  std::vector<std::vector<Literal>> tuples = {
+      {literals[0][0], literals[1][0], literals[2][0]},
+      {literals[0][1], literals[1][1], literals[2][1]},
+      {literals[0][2], literals[1][2], literals[2][2]},
+      {literals[0][0], literals[1][1], literals[2][2]}};
+
+  AddCompactTableConstraint(tuples, &model);
+  SatSolver* sat_solver = model.GetOrCreate<SatSolver>();
+
+  EXPECT_TRUE(sat_solver->EnqueueDecisionIfNotConflicting(literals[0][0]));
+  EXPECT_TRUE(sat_solver->Propagate());
+  EXPECT_TRUE(sat_solver->Assignment().LiteralIsFalse(literals[1][2]));
+  EXPECT_TRUE(sat_solver->Assignment().LiteralIsFalse(literals[2][1]));
+
+  EXPECT_TRUE(sat_solver->EnqueueDecisionIfNotConflicting(literals[1][1]));
+  EXPECT_TRUE(sat_solver->Propagate());
+  EXPECT_TRUE(sat_solver->Assignment().LiteralIsTrue(literals[2][2]));
+
+  // Everything is restored on backtrack.
+  sat_solver->Backtrack(0);
+  EXPECT_TRUE(sat_solver->EnqueueDecisionIfNotConflicting(literals[0][1]));
+  EXPECT_TRUE(sat_solver->Propagate());
+  EXPECT_TRUE(sat_solver->Assignment().LiteralIsTrue(literals[1][1]));
+  EXPECT_TRUE(sat_solver->Assignment().LiteralIsTrue(literals[2][1]));
+}
+
+TEST(CompactTablePropagatorTest, SameSolutionsAsExpansion) {
+  const CpModelProto model_proto = ParseTestProto(R"pb(
+    variables { domain: [ 0, 3 ] }
+    variables { domain: [ 0, 3 ] }
+    variables { domain: [ 0, 3 ] }
+    variables { domain: [ 0, 3 ] }
+    constraints {
+      table {
+        vars: [ 0, 1, 2 ]
+        values: [ 0, 1, 2, 1, 2, 3, 2, 3, 0, 3, 0, 1, 0, 0, 0, 1, 1, 3 ]
+      }
+    }
+    constraints {
+      table {
+        vars: [ 1, 2, 3 ]
+        values: [ 1, 2, 0, 0, 0, 3, 3, 0, 1, 1, 3, 2, 2, 2, 2 ]
+      }
+    }
+  )pb");
+
+  for (const bool use_compact_table : {false, true}) {
+    Model model;
+    SetEnumerateAllSolutions(&model);
+    model.GetOrCreate<SatParameters>()->set_use_compact_table_propagator(
+        use_compact_table);
+    absl::btree_set<std::vector<int64_t>> solutions;
+    model.Add(NewFeasibleSolutionObserver(
+        [&solutions](const CpSolverResponse& response) {
+          solutions.insert(std::vector<int64_t>(response.solution().begin(),
+                                                response.solution().end()));
+        }));
+    const CpSolverResponse response = SolveCpModel(model_proto, &model);
+    EXPECT_EQ(response.status(), CpSolverStatus::OPTIMAL);
+    EXPECT_EQ(solutions,
+              (absl::btree_set<std::vector<int64_t>>{
+                  {0, 0, 0, 3}, {0, 1, 2, 0}, {1, 1, 3, 2}, {2, 3, 0, 1}}));
+  }
+}
+
+// The domains only shrink to make the kept table dense after the expansion
+// (here when probing the enforcement literal of the linear constraints). The
+// table must not be negated then, as the loader only supports positive ones.
+TEST(CompactTablePropagatorTest, DenseTableAfterExpansion) {
+  const CpModelProto model_proto = ParseTestProto(R"pb(
+    variables { domain: [ 0, 3 ] }
+    variables { domain: [ 0, 3 ] }
+    variables { domain: [ 0, 3 ] }
+    variables { domain: [ 0, 1 ] }
+    constraints {
+      table {
+        vars: [ 0, 1, 2 ]
+        values: [
+          0, 0, 1, 0, 0, 2, 0, 0, 3, 0, 1, 0, 0, 1, 1, 0, 1, 2, 0, 1, 3,
+          0, 2, 0, 0, 2, 1, 0, 2, 2, 0, 2, 3, 0, 3, 0, 0, 3, 1, 0, 3, 2,
+          0, 3, 3, 1, 0, 0, 1, 0, 1, 1, 0, 2, 1, 0, 3, 1, 1, 0, 1, 1, 2,
+          1, 1, 3, 1, 2, 0, 1, 2, 1, 1, 2, 2, 1, 2, 3, 1, 3, 0, 1, 3, 1,
+          1, 3, 2, 1, 3, 3, 2, 0, 0, 3, 3, 3
+        ]
+      }
+    }
+    constraints {
+      enforcement_literal: 3
+      linear { vars: 0 coeffs: 1 domain: [ 0, 1 ] }
+    }
+    constraints {
+      enforcement_literal: -4
+      linear { vars: 0 coeffs: 1 domain: [ 0, 1 ] }
+    }
+  )pb");
+
+  Model model;
+  SetEnumerateAllSolutions(&model);
+  model.GetOrCreate<SatParameters>()->set_use_compact_table_propagator(true);
+  int num_solutions = 0;
+  model.Add(NewFeasibleSolutionObserver(
+      [&num_solutions](const CpSolverResponse& response) {
+        EXPECT_LE(response.solution(0), 1);
+        ++num_solutions;
+      }));
+  const CpSolverResponse response = SolveCpModel(model_proto, &model);
+  EXPECT_EQ(response.status(), CpSolverStatus::OPTIMAL);
+  EXPECT_EQ(num_solutions, 60);
+}
+
 }  // namespace
 }  // namespace sat
 }  // namespace operations_research
@@ -472,6 +472,7 @@ bool TimeTablingPerTask::BuildProfile() {
 
   // Save max_height.
   profile_max_height_ = max_height;
+  BuildProfileMaxTree();
 
   // Increase the capacity variable if required.
   return IncreaseCapacity(max_height_start, profile_max_height_);
@@ -484,6 +485,44 @@ void TimeTablingPerTask::ReverseProfile() {
     profile_[i].start = -profile_[i].start;
     profile_[i].height = profile_[i + 1].height;
   }
+  BuildProfileMaxTree();
+}
+
+void TimeTablingPerTask::BuildProfileMaxTree() {
+  const int num_rectangles = profile_.size();
+  for (profile_tree_size_ = 1; profile_tree_size_ < num_rectangles;
+       profile_tree_size_ <<= 1) {
+  }
+  profile_max_tree_.assign(2 * profile_tree_size_, kMinIntegerValue);
+  for (int i = 0; i < num_rectangles; ++i) {
+    profile_max_tree_[profile_tree_size_ + i] = profile_[i].height;
+  }
+  for (int node = profile_tree_size_ - 1; node >= 1; --node) {
+    profile_max_tree_[node] = std::max(profile_max_tree_[2 * node],
+                                       profile_max_tree_[2 * node + 1]);
+  }
+}
+
+int TimeTablingPerTask::NextConflictingRectangle(
+    int from, IntegerValue conflict_height) const {
+  const int last = profile_.size() - 1;
+  if (from >= last) return last;
+
+  // Go up until we find a subtree on the right of from that contains a
+  // conflicting rectangle.
+  int node = profile_tree_size_ + from;
+  while (profile_max_tree_[node] <= conflict_height) {
+    while (node & 1) node >>= 1;
+    if (node == 0) return last;
+    ++node;
+  }
+
+  // Then go down to its first conflicting leaf.
+  while (node < profile_tree_size_) {
+    node *= 2;
+    if (profile_max_tree_[node] <= conflict_height) ++node;
+  }
+  return std::min(node - profile_tree_size_, last);
 }
 
 bool TimeTablingPerTask::SweepAllTasks() {
@@ -542,10 +581,10 @@ bool TimeTablingPerTask::SweepTask(int task_id, IntegerValue initial_start_min,
   IntegerValue new_start_min = initial_start_min;
   if (IsInProfile(task_id)) {
     DCHECK_LE(start_max, initial_end_min);
-    for (; profile_[rec_id].start < start_max; ++rec_id) {
-      // If the profile rectangle is not conflicting, go to the next rectangle.
-      if (profile_[rec_id].height <= conflict_height) continue;
-
+    bool pushed_to_start_max = false;
+    for (rec_id = NextConflictingRectangle(rec_id, conflict_height);
+         profile_[rec_id].start < start_max;
+         rec_id = NextConflictingRectangle(rec_id + 1, conflict_height)) {
       // Compute the next minimum start and end times of task_id. The variables
       // are not updated yet.
       new_start_min = profile_[rec_id + 1].start;  // i.e. profile_[rec_id].end
@@ -553,6 +592,7 @@ bool TimeTablingPerTask::SweepTask(int task_id, IntegerValue initial_start_min,
         // Because the task is part of the profile, we cannot push it further.
         new_start_min = start_max;
         explanation_start_time = start_max - 1;
+        pushed_to_start_max = true;
         break;
       }
       explanation_start_time = new_start_min - 1;
@@ -564,7 +604,14 @@ bool TimeTablingPerTask::SweepTask(int task_id, IntegerValue initial_start_min,
         demands_->DemandMax(task_id) - demands_->DemandMin(task_id);
     if (delta > 0) {
       const IntegerValue threshold = CapacityMax() - delta;
-      if (profile_[rec_id].start > start_max) --rec_id;
+
+      // Start from the rectangle containing start_max, unless we stopped on a
+      // rectangle that also contains it.
+      if (!pushed_to_start_max) {
+        rec_id = std::upper_bound(profile_.begin(), profile_.end(),
+                                  ProfileRectangle(start_max, 0)) -
+                 profile_.begin() - 1;
+      }
       for (; profile_[rec_id].start < initial_end_min; ++rec_id) {
         DCHECK_GT(profile_[rec_id + 1].start, start_max);
         if (profile_[rec_id].height <= threshold) continue;
@@ -585,10 +632,9 @@ bool TimeTablingPerTask::SweepTask(int task_id, IntegerValue initial_start_min,
   } else {
     IntegerValue limit = initial_end_min;
     const IntegerValue size_min = helper_->SizeMin(task_id);
-    for (; profile_[rec_id].start < limit; ++rec_id) {
-      // If the profile rectangle is not conflicting, go to the next rectangle.
-      if (profile_[rec_id].height <= conflict_height) continue;
-
+    for (rec_id = NextConflictingRectangle(rec_id, conflict_height);
+         profile_[rec_id].start < limit;
+         rec_id = NextConflictingRectangle(rec_id + 1, conflict_height)) {
       // Compute the next minimum start and end times of task_id. The variables
       // are not updated yet.
       new_start_min = profile_[rec_id + 1].start;  // i.e. profile_[rec_id].end
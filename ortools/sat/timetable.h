@@ -144,6 +144,15 @@ class TimeTablingPerTask : public PropagatorInterface {
   // both the start and end times.
   void ReverseProfile();
 
+  // Builds profile_max_tree_ from the current profile_.
+  void BuildProfileMaxTree();
+
+  // Returns the index of the first profile rectangle at or after from that has
+  // a height larger than conflict_height, or the index of the last sentinel if
+  // there is none. This is in O(log(profile size)) and allows SweepTask() to
+  // skip all the non-conflicting rectangles at once.
+  int NextConflictingRectangle(int from, IntegerValue conflict_height) const;
+
   // Tries to increase the minimum start time of each task according to the
   // current profile. This function can be called after ReverseProfile() and
   // ReverseVariables to update the maximum end time of each task.
@@ -195,6 +204,12 @@ class TimeTablingPerTask : public PropagatorInterface {
   std::vector<ProfileRectangle> profile_;
   IntegerValue profile_max_height_;
 
+  // Segment tree with the maximum height of the profile rectangles. The leaves
+  // are in [profile_tree_size_, 2 * profile_tree_size_) and node i is the
+  // maximum of its two children 2 * i and 2 * i + 1.
+  int profile_tree_size_ = 0;
+  std::vector<IntegerValue> profile_max_tree_;
+
   // Reversible set (with random access) of tasks to consider for building the
   // profile. The set contains the tasks in the [0, num_profile_tasks_) prefix
   // of profile_tasks_.
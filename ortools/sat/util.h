@@ -758,10 +758,11 @@ inline void CompactVectorVector<K, V>::AppendToLastVector(const V& value) {
 template <typename K, typename V>
 inline void CompactVectorVector<K, V>::ReplaceValuesBySmallerSet(
     K key, absl::Span<const V> values) {
-  CHECK_LE(values.size(), sizes_[key]);
-  sizes_[key] = values.size();
+  const int k = InternalKey(key);
+  CHECK_LE(values.size(), sizes_[k]);
+  sizes_[k] = values.size();
   if (values.empty()) return;
-  memcpy(&buffer_[starts_[key]], values.data(), sizeof(V) * values.size());
+  memcpy(&buffer_[starts_[k]], values.data(), sizeof(V) * values.size());
 }
 
 template <typename K, typename V>
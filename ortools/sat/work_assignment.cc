@@ -900,4 +900,40 @@ std::optional<ProtoLiteral> SharedTreeWorker::EncodeDecision(Literal decision) {
   return ProtoLiteral::Encode(decision, mapping_, encoder_);
 }
 
+int SharedLbTreeSearchNodes::RegisterNewId() {
+  absl::MutexLock l(&mu_);
+  id_to_num_seen_.push_back(0);
+  return id_to_num_seen_.size() - 1;
+}
+
+void SharedLbTreeSearchNodes::AddNode(int id,
+                                      absl::Span<const ProtoLiteral> decisions,
+                                      IntegerValue objective_lb) {
+  absl::MutexLock l(&mu_);
+  if (objective_lbs_.size() >= kMaxNumNodes) return;
+  decisions_.Add(decisions);
+  objective_lbs_.push_back(objective_lb);
+  sender_ids_.push_back(id);
+}
+
+std::vector<std::pair<std::vector<ProtoLiteral>, IntegerValue>>
+SharedLbTreeSearchNodes::GetNewNodes(int id) {
+  std::vector<std::pair<std::vector<ProtoLiteral>, IntegerValue>> result;
+  absl::MutexLock l(&mu_);
+  for (int i = id_to_num_seen_[id]; i < objective_lbs_.size(); ++i) {
+    if (sender_ids_[i] == id) continue;
+    const absl::Span<const ProtoLiteral> decisions = decisions_[i];
+    result.push_back({std::vector<ProtoLiteral>(decisions.begin(),
+                                                decisions.end()),
+                      objective_lbs_[i]});
+  }
+  id_to_num_seen_[id] = objective_lbs_.size();
+  return result;
+}
+
+int SharedLbTreeSearchNodes::NumNodes() const {
+  absl::MutexLock l(&mu_);
+  return objective_lbs_.size();
+}
+
 }  // namespace operations_research::sat
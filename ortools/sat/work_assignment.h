@@ -377,6 +377,45 @@ class SharedTreeWorker {
   std::deque<int> rev_num_processed_implications_;
 };
 
+// Thread-safe store of the objective lower bounds proven at the nodes of the
+// lb_tree_search workers. This allows several of these workers to cooperate on
+// the same search tree: a subtree closed by one worker does not need to be
+// explored again by the others.
+//
+// A node is given by the decisions leading to it, and its bound means that all
+// the solutions in which these decisions hold have an inner objective greater
+// or equal to objective_lb.
+class SharedLbTreeSearchNodes {
+ public:
+  SharedLbTreeSearchNodes() = default;
+  SharedLbTreeSearchNodes(const SharedLbTreeSearchNodes&) = delete;
+  SharedLbTreeSearchNodes& operator=(const SharedLbTreeSearchNodes&) = delete;
+
+  // Returns the id to use in the functions below.
+  int RegisterNewId() ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Adds a node proven by the worker with the given id. To bound the memory,
+  // new nodes are ignored once kMaxNumNodes are stored.
+  void AddNode(int id, absl::Span<const ProtoLiteral> decisions,
+               IntegerValue objective_lb) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Returns the nodes added by the other workers since the last call with the
+  // same id.
+  std::vector<std::pair<std::vector<ProtoLiteral>, IntegerValue>> GetNewNodes(
+      int id) ABSL_LOCKS_EXCLUDED(mu_);
+
+  int NumNodes() const ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  static constexpr int kMaxNumNodes = 100'000;
+
+  mutable absl::Mutex mu_;
+  std::vector<int> id_to_num_seen_ ABSL_GUARDED_BY(mu_);
+  CompactVectorVector<int, ProtoLiteral> decisions_ ABSL_GUARDED_BY(mu_);
+  std::vector<IntegerValue> objective_lbs_ ABSL_GUARDED_BY(mu_);
+  std::vector<int> sender_ids_ ABSL_GUARDED_BY(mu_);
+};
+
 }  // namespace operations_research::sat
 
 #endif  // OR_TOOLS_SAT_WORK_ASSIGNMENT_H_